@@ -9,6 +9,7 @@ verbose=true
 memorylimit=32
 timelimit=3600
 time_hard=10
+exploration=''
 
 #parse command line arguments
 POSITIONAL=()
@@ -33,6 +34,11 @@ case $key in
     shift # past argument
     shift # past value
     ;;
+    -e|--exploration)
+    exploration="$2"
+    shift # past argument
+    shift # past value
+    ;;
     -o|--output)
     OUT_DIR=$2
     shift # past argument
@@ -74,6 +80,7 @@ if [ "$show_help" == true ]; then
     echo "    -b, --benchmark <RESULTS> Output benchmarking information to RESULTS"
     echo "    -m, --memorylimit <LIMIT> Enforce a memory limit of LIMIT GB"
     echo "    -t, --timelimit <LIMIT>   Enforce a time limit of LIMIT seconds"
+    echo "    -e, --exploration <MODE>  Pass the exploration options MODE to Strix"
     echo "ARGS:"
     echo "    <BENCHMARK_DIR>           The directory containing the benchmark files"
     exit 0
@@ -122,6 +129,9 @@ if [ "$synthesis" == true ]; then
 else
     STRIX_OPTIONS="$STRIX_OPTIONS --realizability"
 fi
+if [ -n "$exploration" ]; then
+    STRIX_OPTIONS="$STRIX_OPTIONS -e $exploration"
+fi
 
 function run_strix {
     LTL_FILE=$1
@@ -8,7 +8,15 @@
 
 #include <boost/functional/hash.hpp>
 
-typedef uint64_t letter_t;
+#include "util/Letter.h"
+
+// number of 64-bit words of a letter, set by the CMake option MAX_SIGNALS
+#ifndef LETTER_WORDS
+#define LETTER_WORDS 1
+#endif
+
+typedef letter_type<LETTER_WORDS>::type letter_t;
+constexpr size_t LETTER_BITS = std::numeric_limits<letter_t>::digits;
 constexpr letter_t MIN_LETTER = std::numeric_limits<letter_t>::min();
 constexpr letter_t MAX_LETTER = std::numeric_limits<letter_t>::max();
 
@@ -91,8 +99,20 @@ struct ScoredEdge {
 
 enum class ExplorationStrategy {
     BFS,
-    PQ
+    DFS,
+    PQ,
+    BEAM,
+    COLOR
 };
 
 std::ostream& operator<<(std::ostream& out, const ExplorationStrategy& exploration);
 std::istream& operator>>(std::istream& in, ExplorationStrategy& exploration);
+
+// search for the number of states of a minimized Mealy machine
+enum class MinimizationSearch {
+    LINEAR,
+    GALLOPING
+};
+
+std::ostream& operator<<(std::ostream& out, const MinimizationSearch& search);
+std::istream& operator>>(std::istream& in, MinimizationSearch& search);
@@ -0,0 +1,171 @@
+#include "AigBuilder.h"
+
+#include <utility>
+
+namespace aig {
+
+// initial size of the hash table, which is kept at most half full
+constexpr size_t INITIAL_TABLE_SIZE = 1024;
+
+AigBuilder::AigBuilder(aiger* aig, const var_t first_var) :
+    aig(aig), first_var(first_var), next_var(first_var),
+    table(INITIAL_TABLE_SIZE, 0), mask(INITIAL_TABLE_SIZE - 1)
+{}
+
+void AigBuilder::grow() {
+    std::vector<var_t> old_table(2 * table.size(), 0);
+    std::swap(table, old_table);
+    mask = table.size() - 1;
+    for (const var_t var : old_table) {
+        if (var != 0) {
+            size_t i = hash(fanins0[var - first_var], fanins1[var - first_var]);
+            while (table[i] != 0) {
+                i = (i + 1) & mask;
+            }
+            table[i] = var;
+        }
+    }
+}
+
+literal_t AigBuilder::lookupOrAdd(const literal_t lhs, const literal_t rhs) {
+    size_t i = hash(lhs, rhs);
+    while (table[i] != 0) {
+        const var_t var = table[i];
+        if (fanins0[var - first_var] == lhs && fanins1[var - first_var] == rhs) {
+            return aiger_var2lit(var);
+        }
+        i = (i + 1) & mask;
+    }
+
+    const var_t var = next_var++;
+    const literal_t lit = aiger_var2lit(var);
+    aiger_add_and(aig, lit, lhs, rhs);
+    fanins0.push_back(lhs);
+    fanins1.push_back(rhs);
+    table[i] = var;
+    if (2 * numberOfGates() > table.size()) {
+        grow();
+    }
+    return lit;
+}
+
+// two-level rewrite rules for a conjunction where at least one side is a gate
+literal_t AigBuilder::rewrite(const literal_t lhs, const literal_t rhs, bool& rewritten) {
+    rewritten = true;
+    for (int side = 0; side < 2; side++) {
+        const literal_t g = side == 0 ? lhs : rhs;
+        const literal_t x = side == 0 ? rhs : lhs;
+        if (!isGate(g)) {
+            continue;
+        }
+        const literal_t g0 = fanin0(g);
+        const literal_t g1 = fanin1(g);
+        if (!aiger_sign(g)) {
+            if (g0 == aiger_not(x) || g1 == aiger_not(x)) {
+                // contradiction: (a & b) & !a = 0
+                return aiger_false;
+            }
+            if (g0 == x || g1 == x) {
+                // idempotence: (a & b) & a = a & b
+                return g;
+            }
+        }
+        else {
+            if (g0 == aiger_not(x) || g1 == aiger_not(x)) {
+                // subsumption: !(a & b) & !a = !a
+                return x;
+            }
+            if (g0 == x) {
+                // substitution: !(a & b) & a = a & !b
+                return add_and(x, aiger_not(g1));
+            }
+            if (g1 == x) {
+                return add_and(x, aiger_not(g0));
+            }
+        }
+    }
+
+    if (isGate(lhs) && isGate(rhs)) {
+        const literal_t a[2] = { fanin0(lhs), fanin1(lhs) };
+        const literal_t b[2] = { fanin0(rhs), fanin1(rhs) };
+        const bool neg_lhs = aiger_sign(lhs);
+        const bool neg_rhs = aiger_sign(rhs);
+        for (int i = 0; i < 2; i++) {
+            for (int j = 0; j < 2; j++) {
+                if (a[i] != aiger_not(b[j])) {
+                    continue;
+                }
+                if (!neg_lhs && !neg_rhs) {
+                    // contradiction: (a & b) & (!a & c) = 0
+                    return aiger_false;
+                }
+                else if (!neg_lhs && neg_rhs) {
+                    // subsumption: (a & b) & !(!a & c) = a & b
+                    return lhs;
+                }
+                else if (neg_lhs && !neg_rhs) {
+                    return rhs;
+                }
+                else if (a[1 - i] == b[1 - j]) {
+                    // resolution: !(a & b) & !(!a & b) = !b
+                    return aiger_not(a[1 - i]);
+                }
+            }
+        }
+    }
+
+    rewritten = false;
+    return aiger_false;
+}
+
+literal_t AigBuilder::add_and(literal_t lhs, literal_t rhs) {
+    if (lhs == rhs) {
+        return lhs;
+    }
+    else if (lhs == aiger_not(rhs) || lhs == aiger_false || rhs == aiger_false) {
+        return aiger_false;
+    }
+    else if (lhs == aiger_true) {
+        return rhs;
+    }
+    else if (rhs == aiger_true) {
+        return lhs;
+    }
+    else if (lhs > rhs) {
+        // normalize for hash table
+        std::swap(lhs, rhs);
+    }
+
+    bool rewritten;
+    const literal_t lit = rewrite(lhs, rhs, rewritten);
+    if (rewritten) {
+        return lit;
+    }
+    return lookupOrAdd(lhs, rhs);
+}
+
+literal_t AigBuilder::add_ite(const literal_t cond, const literal_t then_lit, const literal_t else_lit) {
+    if (then_lit == else_lit || cond == aiger_true) {
+        return then_lit;
+    }
+    else if (cond == aiger_false) {
+        return else_lit;
+    }
+    else if (then_lit == aiger_true || then_lit == cond) {
+        return add_or(cond, else_lit);
+    }
+    else if (then_lit == aiger_false || then_lit == aiger_not(cond)) {
+        return add_and(aiger_not(cond), else_lit);
+    }
+    else if (else_lit == aiger_false || else_lit == cond) {
+        return add_and(cond, then_lit);
+    }
+    else if (else_lit == aiger_true || else_lit == aiger_not(cond)) {
+        return add_or(aiger_not(cond), then_lit);
+    }
+    else {
+        return add_or(add_and(cond, then_lit), add_and(aiger_not(cond), else_lit));
+    }
+}
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+extern "C" {
+#include "aiger/aiger.h"
+}
+
+namespace aig {
+    typedef uint64_t literal_t;
+    typedef uint32_t var_t;
+
+    /*
+     * Adds and gates to an AIGER circuit with structural hashing, so that
+     * each pair of fanins is only added once, and local two-level rewrites
+     * (contradiction, idempotence, subsumption, substitution, resolution)
+     * that avoid gates which are redundant with their fanins.
+     * Gates are numbered consecutively from the first free variable on.
+     */
+    class AigBuilder {
+        private:
+            aiger* aig;
+            const var_t first_var;
+            var_t next_var;
+
+            // fanins of the added gates, indexed by variable - first_var
+            std::vector<literal_t> fanins0;
+            std::vector<literal_t> fanins1;
+
+            // open-addressed hash table with linear probing of the added gates,
+            // storing the gate variable or 0 for an empty slot
+            std::vector<var_t> table;
+            size_t mask;
+
+            inline bool isGate(const literal_t lit) const {
+                const var_t var = aiger_lit2var(lit);
+                return var >= first_var && var < next_var;
+            }
+            inline literal_t fanin0(const literal_t lit) const {
+                return fanins0[aiger_lit2var(lit) - first_var];
+            }
+            inline literal_t fanin1(const literal_t lit) const {
+                return fanins1[aiger_lit2var(lit) - first_var];
+            }
+            inline size_t hash(const literal_t lhs, const literal_t rhs) const {
+                return (size_t)(((lhs * 0x9e3779b97f4a7c15ULL) ^ rhs) * 0xbf58476d1ce4e5b9ULL >> 17) & mask;
+            }
+
+            void grow();
+            literal_t rewrite(const literal_t lhs, const literal_t rhs, bool& rewritten);
+            literal_t lookupOrAdd(const literal_t lhs, const literal_t rhs);
+
+        public:
+            AigBuilder(aiger* aig, const var_t first_var);
+
+            literal_t add_and(literal_t lhs, literal_t rhs);
+            inline literal_t add_or(const literal_t lhs, const literal_t rhs) {
+                return aiger_not(add_and(aiger_not(lhs), aiger_not(rhs)));
+            }
+            // if-then-else, i.e. a multiplexer with the condition as select signal
+            literal_t add_ite(const literal_t cond, const literal_t then_lit, const literal_t else_lit);
+
+            inline size_t numberOfGates() const { return next_var - first_var; }
+    };
+}
@@ -2,15 +2,25 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <cerrno>
+#include <algorithm>
+#include <limits>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
 #include <thread>
 
-#include <boost/filesystem/operations.hpp>
-#include <boost/filesystem/path.hpp>
-#include <boost/iostreams/device/file_descriptor.hpp>
-#include <boost/iostreams/stream.hpp>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include "util/Profiler.h"
+#include "util/Statistics.h"
+
 namespace aig {
 
 // wrapper to use std::ostream as FILE* pointer
@@ -50,11 +60,20 @@ struct STDIOAdapter {
     }
 };
 
-AigerConstructor::AigerConstructor(const mealy::MealyMachine& m, const bool use_labels, const bool minimize) :
-    m(m), use_labels(use_labels), minimize(minimize), aig(aiger_init())
+AigerConstructor::AigerConstructor(const mealy::MealyMachine& m, const bool use_labels, const bool minimize, const int threads,
+        const StateEncoding encoding) :
+    m(m), use_labels(use_labels), minimize(minimize), encoding(encoding), aig(aiger_init()),
+    threads(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())),
+    reordering_budget(0)
 {
+    const transition_vec& machine = m.getTransitions(minimize);
     if (use_labels) {
         n_latches = m.getStateLabelBits();
+        for (mealy::state_id_t s = 0; s < machine.size(); s++) {
+            const SpecSeq<node_id_t> label = m.getStateLabel(s, minimize);
+            state_codes.push_back(SpecSeq<letter_t>(label.number, label.unspecifiedBits));
+        }
+        current_state_codes = state_codes;
     }
     else {
         if (minimize) {
@@ -63,171 +82,232 @@ AigerConstructor::AigerConstructor(const mealy::MealyMachine& m, const bool use_
         else {
             n_states = m.numberOfStates();
         }
-        n_latches = (size_t)ceil(log2(n_states));
+        n_latches = numberOfLatches(encoding, n_states);
+        state_codes = encodeStates(encoding, machine);
+        current_state_codes = currentStateCodes(encoding, state_codes);
     }
-    and_gate_index = m.n_inputs + n_latches;
 }
 
 AigerConstructor::~AigerConstructor() {
     aiger_reset(aig);
 }
 
-BDD AigerConstructor::constructBDDForVar(var_t var, const transition_vec& machine) {
-    BDD bdd = manager.bddZero();
-    bool is_latch_var = false;
-    if (var >= m.n_outputs) {
-        is_latch_var = true;
-        var -= m.n_outputs;
+void AigerConstructor::setInputOrder(std::vector<var_t> order) {
+    if (order.size() != m.n_inputs) {
+        throw std::invalid_argument("Input order has wrong number of inputs: " + std::to_string(order.size()));
     }
-    const letter_t bit = ((letter_t)1 << var);
-    for (mealy::state_id_t s = 0; s < machine.size(); s++) {
-        SpecSeq<node_id_t> cur_state(s);
-        if (use_labels) {
-            cur_state = m.getStateLabel(s, minimize);
-        }
-        for (const auto& t : machine[s]) {
-            SpecSeq<letter_t> outputBits;
-            if (is_latch_var) {
-                if (use_labels) {
-                    SpecSeq<node_id_t> stateBits = m.getStateLabel(t.nextState, minimize);
-                    outputBits = SpecSeq<letter_t>(stateBits.number, stateBits.unspecifiedBits);
-                }
-                else {
-                    outputBits = SpecSeq<letter_t>(t.nextState);
+    input_order = std::move(order);
+}
+
+void AigerConstructor::setReorderingBudget(const std::chrono::duration<double> budget) {
+    reordering_budget = budget;
+}
+
+std::vector<var_t> AigerConstructor::computeInputOrder(const mealy::MealyMachine& m) {
+    std::vector<size_t> uses(m.n_inputs, 0);
+    for (const auto& transitions : m.getTransitions(false)) {
+        for (const auto& t : transitions) {
+            for (var_t input_var = 0; input_var < m.n_inputs; input_var++) {
+                if ((t.input.unspecifiedBits & ((letter_t)1 << input_var)) == 0) {
+                    uses[input_var]++;
                 }
             }
-            else {
-                // TODO: make better use of non-determinism
-                outputBits = t.output[0];
-            }
-            if (((outputBits.unspecifiedBits & bit) == 0) && ((outputBits.number & bit) != 0)) {
-                BDD bdd_input = manager.bddOne();
-
-                if (is_latch_var || m.semantic == mealy::Semantic::MEALY) {
-                    // only latches and Mealy outputs may depend on inputs
-                    for (var_t input_var = 0; input_var < m.n_inputs; input_var++) {
-                        const letter_t input_bit = ((letter_t)1 << input_var);
-                        if ((t.input.unspecifiedBits & input_bit) == 0) {
-                            BDD bdd_input_var = manager.bddVar(input2bddvar(input_var));
-                            if ((t.input.number & input_bit) == 0) {
-                                bdd_input &= !bdd_input_var;
-                            }
-                            else {
-                                bdd_input &= bdd_input_var;
-                            }
-                        }
-                    }
-                }
-                for (var_t latch_var = 0; latch_var < n_latches; latch_var++) {
-                    const mealy::state_id_t latch_bit = ((letter_t)1 << latch_var);
-                    if ((cur_state.unspecifiedBits & latch_bit) == 0) {
-                        BDD bdd_latch_var = manager.bddVar(latch2bddvar(latch_var));
-                        if ((cur_state.number & latch_bit) == 0) {
-                            bdd_input &= !bdd_latch_var;
-                        }
-                        else {
-                            bdd_input &= bdd_latch_var;
-                        }
-                    }
-                }
+        }
+    }
+    std::vector<var_t> order(m.n_inputs);
+    for (var_t input_var = 0; input_var < m.n_inputs; input_var++) {
+        order[input_var] = input_var;
+    }
+    std::stable_sort(order.begin(), order.end(), [&uses](const var_t a, const var_t b) {
+        return uses[a] > uses[b];
+    });
+    return order;
+}
 
-                bdd |= bdd_input;
+Cudd AigerConstructor::createManager() const {
+    const var_t num_vars = m.n_inputs + n_latches;
+    Cudd cudd(num_vars);
+    if (!input_order.empty() && num_vars > 0) {
+        // latches occur in every cube, so alternate them with the most used inputs from the top
+        std::vector<int> permutation;
+        permutation.reserve(num_vars);
+        for (var_t i = 0; i < std::max<var_t>(n_latches, m.n_inputs); i++) {
+            if (i < n_latches) {
+                permutation.push_back(latch2bddvar(i));
             }
-            if (!is_latch_var && m.semantic == mealy::Semantic::MOORE) {
-                // only need to look at one transition for output of state
-                break;
+            if (i < m.n_inputs) {
+                permutation.push_back(input2bddvar(input_order[i]));
             }
         }
+        cudd.ShuffleHeap(permutation.data());
     }
-
-    // minimize function not fully exposed in C++ API, need to call C API
-    //BDD min_bdd(manager, Cudd_bddMinimize(manager.getManager(), bdd.getNode(), care_set.getNode()));
-
-    return bdd;
+    return cudd;
 }
 
-inline literal_t AigerConstructor::add_and(literal_t lhs, literal_t rhs, std::unordered_map<literal_pair_t, literal_t>& aig_cache) {
-    if (lhs == rhs) {
-        return lhs;
-    }
-    else if (lhs == aiger_not(rhs) || lhs == aiger_false || rhs == aiger_false) {
-        return aiger_false;
-    }
-    else if (lhs == aiger_true) {
-        return rhs;
-    }
-    else if (rhs == aiger_true) {
-        return lhs;
+void AigerConstructor::reorder() {
+    const var_t num_vars = m.n_inputs + n_latches;
+    if (reordering_budget.count() > 0) {
+        // exact reordering and a converging sift cannot be interrupted,
+        // so use single sifting passes until convergence or the time limit
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(reordering_budget);
+        long size = manager.ReadNodeCount();
+        long old_size;
+        do {
+            old_size = size;
+            manager.ReduceHeap(CUDD_REORDER_SIFT);
+            size = manager.ReadNodeCount();
+        } while (size < old_size && std::chrono::steady_clock::now() < deadline);
+    }
+    else if (num_vars <= 16) {
+        // use exact reordering up to 16 variables
+        manager.ReduceHeap(CUDD_REORDER_EXACT);
     }
-    else if (lhs > rhs) {
-        // normalize for cache
-        literal_t tmp = lhs;
-        lhs = rhs;
-        rhs = tmp;
+    else {
+        // use sift heuristic until convergence
+        manager.ReduceHeap(CUDD_REORDER_SIFT_CONVERGE);
     }
-    const literal_pair_t key(lhs, rhs);
-    const auto it = aig_cache.find(key);
-    if (it != aig_cache.end()) {
-        return it->second;
+}
+
+// The outputs of each variable are constructed independently, so only one
+// of the allowed outputs can be used, as mixing bits of different outputs may
+// give an output that is not allowed. Choose the one with the most unspecified
+// bits, which all become don't cares.
+static SpecSeq<letter_t> chooseOutput(const std::vector<SpecSeq<letter_t>>& outputs) {
+    size_t best = 0;
+    for (size_t i = 1; i < outputs.size(); i++) {
+        if (popcount(outputs[i].unspecifiedBits) > popcount(outputs[best].unspecifiedBits)) {
+            best = i;
+        }
     }
-    else {
-        and_gate_index++;
-        literal_t lit = aiger_var2lit(and_gate_index);
-        aiger_add_and(aig, lit, lhs, rhs);
-        aig_cache.insert({key, lit});
-        return lit;
+    return outputs[best];
+}
+
+std::vector<AigerConstructor::TransitionCube> AigerConstructor::constructTransitionCubes(const Cudd& cudd, const transition_vec& machine) const {
+    std::vector<TransitionCube> cubes;
+    for (mealy::state_id_t s = 0; s < machine.size(); s++) {
+        const SpecSeq<letter_t>& cur_state = current_state_codes[s];
+        // build cubes from the last variable, so that each conjunction only adds a node on top
+        BDD state_cube = cudd.bddOne();
+        for (var_t latch_var = n_latches; latch_var-- > 0; ) {
+            const letter_t latch_bit = ((letter_t)1 << latch_var);
+            if ((cur_state.unspecifiedBits & latch_bit) == 0) {
+                BDD bdd_latch_var = cudd.bddVar(latch2bddvar(latch_var));
+                if ((cur_state.number & latch_bit) == 0) {
+                    state_cube &= !bdd_latch_var;
+                }
+                else {
+                    state_cube &= bdd_latch_var;
+                }
+            }
+        }
+        bool first = true;
+        for (const auto& t : machine[s]) {
+            BDD cube = state_cube;
+            for (var_t input_var = m.n_inputs; input_var-- > 0; ) {
+                const letter_t input_bit = ((letter_t)1 << input_var);
+                if ((t.input.unspecifiedBits & input_bit) == 0) {
+                    BDD bdd_input_var = cudd.bddVar(input2bddvar(input_var));
+                    if ((t.input.number & input_bit) == 0) {
+                        cube &= !bdd_input_var;
+                    }
+                    else {
+                        cube &= bdd_input_var;
+                    }
+                }
+            }
+            cubes.push_back({ state_cube, cube, chooseOutput(t.output), state_codes[t.nextState], first });
+            first = false;
+        }
     }
+    return cubes;
 }
 
-literal_t AigerConstructor::nodeToLiteral(DdNode* node,
-        std::unordered_map<DdNode*, literal_t>& bdd_cache,
-        std::unordered_map<literal_pair_t, literal_t>& aig_cache
-) {
-    const var_t var = Cudd_NodeReadIndex(node);
-    const bool complement = Cudd_IsComplement(node);
-    literal_t lit;
-    if (var == CUDD_CONST_INDEX) {
-        lit = aiger_true;
+BDD AigerConstructor::constructBDDForVar(const Cudd& cudd, var_t var, const std::vector<TransitionCube>& cubes) const {
+    BDD on_set = cudd.bddZero();
+    BDD care_set = cudd.bddZero();
+    bool is_latch_var = false;
+    if (var >= m.n_outputs) {
+        is_latch_var = true;
+        var -= m.n_outputs;
+    }
+    const letter_t bit = ((letter_t)1 << var);
+    for (const TransitionCube& t : cubes) {
+        if (!is_latch_var && m.semantic == mealy::Semantic::MOORE && !t.first) {
+            // only need to look at one transition for output of state
+            continue;
+        }
+        const SpecSeq<letter_t>& outputBits = is_latch_var ? t.next_state : t.output;
+        if ((outputBits.unspecifiedBits & bit) == 0) {
+            // only latches and Mealy outputs may depend on inputs
+            const BDD& cube = (is_latch_var || m.semantic == mealy::Semantic::MEALY) ? t.cube : t.state_cube;
+            care_set |= cube;
+            if ((outputBits.number & bit) != 0) {
+                on_set |= cube;
+            }
+        }
     }
-    else {
-        DdNode* reg_node = Cudd_Regular(node);
 
-        auto it = bdd_cache.find(reg_node);
-        if (it != bdd_cache.end()) {
-            lit = it->second;
+    // use the unspecified bits and unreachable latch values as don't cares,
+    // and keep the smallest result of the different minimization heuristics
+    BDD bdd = on_set;
+    const auto keepSmaller = [&bdd](const BDD& candidate) {
+        if (candidate.nodeCount() < bdd.nodeCount()) {
+            bdd = candidate;
         }
-        else {
-            DdNode* then_node = Cudd_T(node);
-            DdNode* else_node = Cudd_E(node);
+    };
+    keepSmaller(on_set.Restrict(care_set));
+    keepSmaller(on_set.LICompaction(care_set));
+    // minimize function not fully exposed in C++ API, need to call C API
+    DdNode* min_node = Cudd_bddMinimize(cudd.getManager(), on_set.getNode(), care_set.getNode());
+    if (min_node != nullptr) {
+        keepSmaller(BDD(cudd, min_node));
+    }
 
-            const literal_t then_lit = nodeToLiteral(then_node, bdd_cache, aig_cache);
-            const literal_t else_lit = nodeToLiteral(else_node, bdd_cache, aig_cache);
+    return bdd;
+}
 
-            literal_t var_lit = bddvar2lit(var);
+literal_t AigerConstructor::nodeToLiteral(DdNode* root,
+        std::unordered_map<DdNode*, literal_t>& bdd_cache,
+        AigBuilder& builder
+) const {
+    // literal of a child, where the cache holds the literals of regular nodes
+    const auto childLiteral = [&bdd_cache](DdNode* child) {
+        const literal_t lit = bdd_cache.at(Cudd_Regular(child));
+        return Cudd_IsComplement(child) ? aiger_not(lit) : lit;
+    };
+
+    // post-order traversal with an explicit stack, as BDDs may be very deep
+    std::vector<DdNode*> stack { Cudd_Regular(root) };
+    while (!stack.empty()) {
+        DdNode* node = stack.back();
+        if (bdd_cache.find(node) != bdd_cache.end()) {
+            stack.pop_back();
+            continue;
+        }
+        const var_t var = Cudd_NodeReadIndex(node);
+        if (var == CUDD_CONST_INDEX) {
+            bdd_cache.insert({node, aiger_true});
+            stack.pop_back();
+            continue;
+        }
 
-            // special cases not handled by and gate construction
-            if (then_lit == aiger_false) {
-                lit = add_and(aiger_not(var_lit), else_lit, aig_cache);
+        DdNode* then_node = Cudd_T(node);
+        DdNode* else_node = Cudd_E(node);
+        bool children_done = true;
+        for (DdNode* child : { Cudd_Regular(then_node), Cudd_Regular(else_node) }) {
+            if (bdd_cache.find(child) == bdd_cache.end()) {
+                stack.push_back(child);
+                children_done = false;
             }
-            else if (else_lit == aiger_false) {
-                lit = add_and(var_lit, then_lit, aig_cache);
-            }
-            else {
-                const literal_t then_or_lit = add_and(var_lit, aiger_not(then_lit), aig_cache);
-                const literal_t else_or_lit = add_and(aiger_not(var_lit), aiger_not(else_lit), aig_cache);
-                lit = add_and(aiger_not(then_or_lit), aiger_not(else_or_lit), aig_cache);
-            }
-
-            bdd_cache.insert({reg_node, lit});
+        }
+        if (children_done) {
+            const literal_t lit = builder.add_ite(bddvar2lit(var), childLiteral(then_node), childLiteral(else_node));
+            bdd_cache.insert({node, lit});
+            stack.pop_back();
         }
     }
 
-    if (complement) {
-        return aiger_not(lit);
-    }
-    else {
-        return lit;
-    }
+    return childLiteral(root);
 }
 
 void AigerConstructor::printBDDs(std::ostream& out) const {
@@ -267,17 +347,48 @@ void AigerConstructor::printBDDs(std::ostream& out) const {
 }
 
 void AigerConstructor::constructBDDs() {
-    bdds.reserve(m.n_outputs + n_latches);
+    const var_t num_bdds = m.n_outputs + n_latches;
     const transition_vec& machine = m.getTransitions(minimize);
-    for (var_t var = 0; var < m.n_outputs + n_latches; var++) {
-        BDD bdd = constructBDDForVar(var, machine);
-        bdds.push_back(bdd);
+    const int num_threads = std::min<int>(threads, num_bdds);
+    if (num_threads <= 1) {
+        const std::vector<TransitionCube> cubes = constructTransitionCubes(manager, machine);
+        bdds.reserve(num_bdds);
+        for (var_t var = 0; var < num_bdds; var++) {
+            bdds.push_back(constructBDDForVar(manager, var, cubes));
+        }
+        return;
+    }
+
+    // CUDD managers are not thread-safe, so each thread constructs the BDDs for
+    // every num_threads-th variable in its own manager with its own cubes
+    std::vector<Cudd> managers;
+    managers.reserve(num_threads);
+    std::vector<std::vector<BDD>> thread_bdds(num_threads);
+    std::vector<std::thread> construction_threads;
+    for (int i = 0; i < num_threads; i++) {
+        managers.push_back(createManager());
+    }
+    for (int i = 0; i < num_threads; i++) {
+        construction_threads.emplace_back([this, i, num_threads, num_bdds, &machine, &managers, &thread_bdds]() {
+            const std::vector<TransitionCube> cubes = constructTransitionCubes(managers[i], machine);
+            for (var_t var = i; var < num_bdds; var += num_threads) {
+                thread_bdds[i].push_back(constructBDDForVar(managers[i], var, cubes));
+            }
+        });
+    }
+    for (auto& thread : construction_threads) {
+        thread.join();
+    }
+
+    // transfer the results to the main manager in the order of the variables
+    bdds.reserve(num_bdds);
+    for (var_t var = 0; var < num_bdds; var++) {
+        bdds.push_back(thread_bdds[var % num_threads][var / num_threads].Transfer(manager));
     }
 }
 
 void AigerConstructor::constructAiger(const bool keepBDDs) {
-    const var_t num_vars = m.n_inputs + n_latches;
-    manager = Cudd(num_vars);
+    manager = createManager();
     manager.AutodynEnable();
 
     // construct BDDs
@@ -285,28 +396,21 @@ void AigerConstructor::constructAiger(const bool keepBDDs) {
     manager.AutodynDisable();
 
     // reorder nodes
-    if (num_vars <= 16) {
-        // use exact reordering up to 16 variables
-        manager.ReduceHeap(CUDD_REORDER_EXACT);
-    }
-    else {
-        // use sift heuristic until convergence
-        manager.ReduceHeap(CUDD_REORDER_SIFT_CONVERGE);
-    }
+    reorder();
 
     // construct aiger circuit
     std::unordered_map<DdNode*, literal_t> bdd_cache;
-    std::unordered_map<literal_pair_t, literal_t> aig_cache;
+    AigBuilder builder(aig, m.n_inputs + n_latches + 1);
 
     for (var_t input_var = 0; input_var < m.n_inputs; input_var++) {
         aiger_add_input(aig, input2lit(input_var), m.inputs[input_var].c_str());
     }
     for (var_t output_var = 0; output_var < m.n_outputs; output_var++) {
-        const literal_t output_lit = nodeToLiteral(bdds[output_var].getNode(), bdd_cache, aig_cache);
+        const literal_t output_lit = nodeToLiteral(bdds[output_var].getNode(), bdd_cache, builder);
         aiger_add_output(aig, output_lit, m.outputs[output_var].c_str());
     }
     for (var_t latch_var = 0; latch_var < n_latches; latch_var++) {
-        const literal_t latch_lit = nodeToLiteral(bdds[m.n_outputs + latch_var].getNode(), bdd_cache, aig_cache);
+        const literal_t latch_lit = nodeToLiteral(bdds[m.n_outputs + latch_var].getNode(), bdd_cache, builder);
         std::stringstream latch_name_stream;
         latch_name_stream << "l" << latch_var;
         const std::string latch_name = latch_name_stream.str();
@@ -359,59 +463,132 @@ int AigerConstructor::getAbcNetworkSize(Abc_Frame_t* pAbc) const {
     return Abc_NtkNodeNum(pNtk);
 }
 
-int AigerConstructor::getTmpFile(char* tmp_filename) const {
-    boost::filesystem::path tmpfile_template_path = boost::filesystem::temp_directory_path() / "strix.XXXXXX";
-    std::string tmpfile_template = tmpfile_template_path.string();
-    std::strcpy(tmp_filename, tmpfile_template.c_str());
-    int fd = mkstemp(tmp_filename);
-    if (fd == -1) {
-        throw std::runtime_error("Could not create temporary file: " + std::string(tmp_filename));
+Abc_Ntk_t* AigerConstructor::toAbcNetwork() const {
+    Abc_Ntk_t* pNtk = Abc_NtkAlloc(ABC_NTK_STRASH, ABC_FUNC_AIG, 1);
+    pNtk->pName = Abc_UtilStrsav((char*)"strix");
+    Abc_Aig_t* pMan = (Abc_Aig_t*)pNtk->pManFunc;
+
+    // ABC object for each variable of the circuit, with the constant at variable 0
+    std::vector<Abc_Obj_t*> objects(aig->maxvar + 1, nullptr);
+    objects[0] = Abc_ObjNot(Abc_AigConst1(pNtk));
+    const auto literalToObject = [&](const unsigned lit) {
+        Abc_Obj_t* pObj = objects[aiger_lit2var(lit)];
+        if (pObj == nullptr) {
+            throw std::runtime_error("AIGER circuit is not in topological order: " + std::to_string(lit));
+        }
+        return Abc_ObjNotCond(pObj, aiger_sign(lit));
+    };
+    const auto assignName = [](Abc_Obj_t* pObj, const char* name, const char prefix, const unsigned index, const char* suffix) {
+        const std::string dummy_name = prefix + std::to_string(index);
+        Abc_ObjAssignName(pObj, (char*)(name != nullptr ? name : dummy_name.c_str()), (char*)suffix);
+    };
+
+    for (unsigned i = 0; i < aig->num_inputs; i++) {
+        Abc_Obj_t* pPi = Abc_NtkCreatePi(pNtk);
+        assignName(pPi, aig->inputs[i].name, 'i', i, nullptr);
+        objects[aiger_lit2var(aig->inputs[i].lit)] = pPi;
+    }
+    std::vector<Abc_Obj_t*> latches;
+    for (unsigned i = 0; i < aig->num_latches; i++) {
+        const aiger_symbol& latch = aig->latches[i];
+        Abc_Obj_t* pLatch = Abc_NtkCreateLatch(pNtk);
+        Abc_Obj_t* pLatchIn = Abc_NtkCreateBi(pNtk);
+        Abc_Obj_t* pLatchOut = Abc_NtkCreateBo(pNtk);
+        Abc_ObjAddFanin(pLatch, pLatchIn);
+        Abc_ObjAddFanin(pLatchOut, pLatch);
+        if (latch.reset == 0) {
+            Abc_LatchSetInit0(pLatch);
+        }
+        else if (latch.reset == 1) {
+            Abc_LatchSetInit1(pLatch);
+        }
+        else {
+            Abc_LatchSetInitDc(pLatch);
+        }
+        assignName(pLatchOut, latch.name, 'l', i, nullptr);
+        assignName(pLatchIn, latch.name, 'l', i, "_in");
+        objects[aiger_lit2var(latch.lit)] = pLatchOut;
+        latches.push_back(pLatch);
+    }
+    for (unsigned i = 0; i < aig->num_ands; i++) {
+        const aiger_and& gate = aig->ands[i];
+        objects[aiger_lit2var(gate.lhs)] = Abc_AigAnd(pMan, literalToObject(gate.rhs0), literalToObject(gate.rhs1));
+    }
+    for (unsigned i = 0; i < aig->num_latches; i++) {
+        Abc_ObjAddFanin(Abc_ObjFanin0(latches[i]), literalToObject(aig->latches[i].next));
+    }
+    for (unsigned i = 0; i < aig->num_outputs; i++) {
+        Abc_Obj_t* pPo = Abc_NtkCreatePo(pNtk);
+        assignName(pPo, aig->outputs[i].name, 'o', i, nullptr);
+        Abc_ObjAddFanin(pPo, literalToObject(aig->outputs[i].lit));
+    }
+
+    Abc_AigCleanup(pMan);
+    if (!Abc_NtkCheck(pNtk)) {
+        Abc_NtkDelete(pNtk);
+        throw std::runtime_error("Could not convert AIGER circuit to ABC network");
     }
-    return fd;
+    return pNtk;
 }
 
-void AigerConstructor::writeToAbc(Abc_Frame_t* pAbc) const {
-    char tmp_filename[256];
-    int fd = getTmpFile(tmp_filename);
+void AigerConstructor::fromAbcNetwork(Abc_Ntk_t* pNtk) {
+    if (!Abc_NtkIsStrash(pNtk)) {
+        throw std::runtime_error("ABC network is not a structurally hashed AIG");
+    }
 
-    // write AIGER out to be read by ABC
-    FILE* file = fdopen(fd, "w");
-    if (file == nullptr) {
-        throw std::runtime_error("Could not open temporary file: " + std::string(tmp_filename));
+    aiger_reset(aig);
+    aig = aiger_init();
+
+    // number inputs, latches and gates in this order, where
+    // each gate comes after its fanins in depth-first order
+    std::vector<unsigned> literals(Abc_NtkObjNumMax(pNtk), 0);
+    literals[Abc_ObjId(Abc_AigConst1(pNtk))] = aiger_true;
+    const auto faninLiteral = [&](Abc_Obj_t* pObj, const int fanin) {
+        return literals[Abc_ObjFaninId(pObj, fanin)] ^ (fanin == 0 ? Abc_ObjFaninC0(pObj) : Abc_ObjFaninC1(pObj));
+    };
+    unsigned var = 0;
+
+    Abc_Obj_t* pObj;
+    int i;
+    Abc_NtkForEachPi(pNtk, pObj, i) {
+        literals[Abc_ObjId(pObj)] = aiger_var2lit(++var);
+        aiger_add_input(aig, literals[Abc_ObjId(pObj)], Abc_ObjName(pObj));
+    }
+    Abc_NtkForEachLatch(pNtk, pObj, i) {
+        literals[Abc_ObjId(Abc_ObjFanout0(pObj))] = aiger_var2lit(++var);
+    }
+    Vec_Ptr_t* vNodes = Abc_AigDfs(pNtk, 0, 0);
+    Vec_PtrForEachEntry(Abc_Obj_t*, vNodes, pObj, i) {
+        literals[Abc_ObjId(pObj)] = aiger_var2lit(++var);
+        aiger_add_and(aig, literals[Abc_ObjId(pObj)], faninLiteral(pObj, 0), faninLiteral(pObj, 1));
+    }
+    Vec_PtrFree(vNodes);
+    Abc_NtkForEachLatch(pNtk, pObj, i) {
+        Abc_Obj_t* pLatchOut = Abc_ObjFanout0(pObj);
+        const unsigned lit = literals[Abc_ObjId(pLatchOut)];
+        aiger_add_latch(aig, lit, faninLiteral(Abc_ObjFanin0(pObj), 0), Abc_ObjName(pLatchOut));
+        if (Abc_LatchIsInit1(pObj)) {
+            aiger_add_reset(aig, lit, 1);
+        }
+        else if (Abc_LatchIsInitDc(pObj)) {
+            aiger_add_reset(aig, lit, lit);
+        }
     }
-    int write_result = write_aiger(file, true);
-    fclose(file);
-    if (write_result == 0) {
-        throw std::runtime_error("Could not write AIGER circuit to file: " + std::string(tmp_filename));
+    Abc_NtkForEachPo(pNtk, pObj, i) {
+        aiger_add_output(aig, faninLiteral(pObj, 0), Abc_ObjName(pObj));
     }
+}
 
-    std::stringstream read_command;
-    read_command << "read_aiger " << tmp_filename;
-    executeAbcCommand(pAbc, read_command.str());
-
-    std::remove(tmp_filename);
+void AigerConstructor::writeToAbc(Abc_Frame_t* pAbc) const {
+    Abc_FrameReplaceCurrentNetwork(pAbc, toAbcNetwork());
 }
 
 void AigerConstructor::readFromAbc(Abc_Frame_t* pAbc) {
-    char tmp_filename[256];
-    int fd = getTmpFile(tmp_filename);
-
-    std::stringstream write_command;
-    write_command << "write_aiger -s " << tmp_filename;
-    executeAbcCommand(pAbc, write_command.str());
-
-    // read AIGER back, delete comments added by ABC
-    FILE* file = fdopen(fd, "r");
-    if (file == nullptr) {
-        throw std::runtime_error("Could not open temporary file: " + std::string(tmp_filename));
-    }
-    const char* read_result = read_aiger(file);
-    fclose(file);
-    std::remove(tmp_filename);
-    if (read_result != nullptr) {
-        throw std::runtime_error("Could not read AIGER circuit from file: " + std::string(tmp_filename) + ": " + std::string(read_result));
+    Abc_Ntk_t* pNtk = Abc_FrameReadNtk(pAbc);
+    if (pNtk == nullptr) {
+        throw std::runtime_error("No ABC network to read AIGER circuit from");
     }
-    aiger_delete_comments(aig);
+    fromAbcNetwork(pNtk);
 }
 
 void AigerConstructor::compressAiger(Abc_Frame_t* pAbc) {
@@ -430,6 +607,7 @@ void AigerConstructor::compressAiger(Abc_Frame_t* pAbc) {
 }
 
 void AigerConstructor::construct(const bool compress, const bool keepBDDs) {
+    PROFILE_ZONE("AigerConstructor::construct");
     constructAiger(keepBDDs);
 
     if (compress) {
@@ -478,15 +656,43 @@ void AigerConstructor::print_dot(std::ostream& out) const {
 
     writeToAbc(pAbc);
 
-    char tmp_filename[256];
-    int fd = getTmpFile(tmp_filename);
+    // ABC only writes DOT files, so let it write into a pipe that is read concurrently
+    int fds[2];
+    if (pipe(fds) != 0) {
+        Abc_Stop();
+        throw std::runtime_error("Could not create pipe for DOT output");
+    }
+    std::string dot;
+    std::thread reader([&dot, fd = fds[0]]() {
+        char buffer[4096];
+        ssize_t n;
+        while ((n = read(fd, buffer, sizeof(buffer))) != 0) {
+            if (n > 0) {
+                dot.append(buffer, n);
+            }
+            else if (errno != EINTR) {
+                break;
+            }
+        }
+        close(fd);
+    });
     std::stringstream dot_command;
-    dot_command << "write_dot " << tmp_filename;
-    executeAbcCommand(pAbc, dot_command.str());
+    dot_command << "write_dot /dev/fd/" << fds[1];
+    try {
+        executeAbcCommand(pAbc, dot_command.str());
+    }
+    catch (...) {
+        close(fds[1]);
+        reader.join();
+        Abc_Stop();
+        throw;
+    }
+    close(fds[1]);
+    reader.join();
 
     Abc_Stop();
 
-    boost::iostreams::stream<boost::iostreams::file_descriptor_source> in(fd, boost::iostreams::close_handle);
+    std::istringstream in(dot);
     // filter title tags
     std::string line;
     int block_depth = 0;
@@ -539,22 +745,166 @@ void AigerConstructor::print_dot(std::ostream& out) const {
             out << line << std::endl;
         }
     }
-    in.close();
-
-    std::remove(tmp_filename);
 }
 
-std::shared_ptr<AigerConstructor> AigerConstructor::findMinimalAiger(const mealy::MealyMachine& m, const bool use_labels, const bool use_minimal, const bool compress, const bool keepBDDs) {
-    std::vector<std::shared_ptr<AigerConstructor>> configurations;
-    configurations.reserve(3);
+void AigerConstructor::compressInProcesses(const std::vector<std::shared_ptr<AigerConstructor>>& configurations, const std::chrono::duration<double> timeout) {
+    struct Worker {
+        std::shared_ptr<AigerConstructor> conf;
+        pid_t pid;
+        int fd;
+        std::string circuit;
+        bool done;
+    };
+    std::vector<Worker> workers;
+
+    // the parent always waits with a deadline, as a worker may deadlock after the fork
+    if (timeout.count() <= 0) {
+        throw std::invalid_argument("Parallel compression needs a positive time limit");
+    }
+
+    // flush buffered output so that it is not duplicated in the worker processes
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+
+    for (const auto& conf : configurations) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            throw std::runtime_error("Could not create pipe for compression process");
+        }
+        const pid_t pid = fork();
+        if (pid == -1) {
+            close(fds[0]);
+            close(fds[1]);
+            throw std::runtime_error("Could not fork compression process");
+        }
+        if (pid == 0) {
+            // worker process: compress with its own instance of ABC and write the circuit to the pipe
+            close(fds[0]);
+            for (const Worker& worker : workers) {
+                close(worker.fd);
+            }
+            int status = EXIT_FAILURE;
+            try {
+                Abc_Start();
+                Abc_Frame_t* pAbc = Abc_FrameGetGlobalFrame();
+                conf->compressAiger(pAbc);
+                FILE* file = fdopen(fds[1], "w");
+                if (file != nullptr && conf->write_aiger(file, true) != 0 && std::fflush(file) == 0) {
+                    status = EXIT_SUCCESS;
+                }
+            }
+            catch (...) { }
+            // skip destructors and exit handlers of the parent process
+            _exit(status);
+        }
+        close(fds[1]);
+        workers.push_back({ conf, pid, fds[0], std::string(), false });
+    }
+
+    // read all pipes concurrently, as the workers block once a pipe is full
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+    std::vector<char> buffer(1 << 16);
+    std::vector<pollfd> poll_fds;
+    std::vector<size_t> poll_workers;
+    while (true) {
+        poll_fds.clear();
+        poll_workers.clear();
+        for (size_t i = 0; i < workers.size(); i++) {
+            if (!workers[i].done) {
+                poll_fds.push_back({ workers[i].fd, POLLIN, 0 });
+                poll_workers.push_back(i);
+            }
+        }
+        if (poll_fds.empty()) {
+            break;
+        }
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+        if (remaining <= 0) {
+            break;
+        }
+        const int poll_timeout = std::min<long long>(remaining, std::numeric_limits<int>::max());
+        const int result = poll(poll_fds.data(), poll_fds.size(), poll_timeout);
+        if (result < 0 && errno != EINTR) {
+            break;
+        }
+        for (size_t k = 0; result > 0 && k < poll_fds.size(); k++) {
+            if (poll_fds[k].revents == 0) {
+                continue;
+            }
+            Worker& worker = workers[poll_workers[k]];
+            const ssize_t n = read(worker.fd, buffer.data(), buffer.size());
+            if (n > 0) {
+                worker.circuit.append(buffer.data(), n);
+            }
+            else if (n == 0 || errno != EINTR) {
+                close(worker.fd);
+                worker.done = true;
+            }
+        }
+    }
 
+    for (Worker& worker : workers) {
+        if (!worker.done) {
+            // compression did not finish in time, keep the uncompressed circuit
+            Statistics::counter("aiger.compression_timeouts").add();
+            kill(worker.pid, SIGKILL);
+            close(worker.fd);
+        }
+        int status = 0;
+        while (waitpid(worker.pid, &status, 0) == -1 && errno == EINTR);
+        if (!worker.done || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+            continue;
+        }
+
+        FILE* file = fmemopen(&worker.circuit[0], worker.circuit.size(), "r");
+        if (file == nullptr) {
+            throw std::runtime_error("Could not open compressed AIGER circuit");
+        }
+        const char* read_result = worker.conf->read_aiger(file);
+        fclose(file);
+        if (read_result != nullptr) {
+            throw std::runtime_error("Could not read compressed AIGER circuit: " + std::string(read_result));
+        }
+    }
+}
+
+std::shared_ptr<AigerConstructor> AigerConstructor::findMinimalAiger(const mealy::MealyMachine& m, const bool use_labels, const bool use_minimal, const bool compress, const bool keepBDDs,
+        const bool parallel_compression, const std::chrono::duration<double> compression_timeout, const int num_threads,
+        const std::chrono::duration<double> reordering_budget) {
+    // configurations of labels, minimization and state encoding
+    std::vector<std::tuple<bool, bool, StateEncoding>> settings;
     if (use_labels) {
-        configurations.push_back(std::shared_ptr<AigerConstructor>(new AigerConstructor(m, true, false)));
+        settings.push_back({ true, false, StateEncoding::BINARY });
     }
     if (use_minimal) {
-        configurations.push_back(std::shared_ptr<AigerConstructor>(new AigerConstructor(m, false, true)));
+        settings.push_back({ false, true, StateEncoding::BINARY });
+    }
+    settings.push_back({ false, false, StateEncoding::BINARY });
+
+    // try other encodings only for the smallest machine without labels
+    const mealy::state_id_t n_states = use_minimal ? m.numberOfMinStates() : m.numberOfStates();
+    for (const StateEncoding encoding : { StateEncoding::GRAY, StateEncoding::ONE_HOT, StateEncoding::CLUSTERED }) {
+        if (n_states > 2 && isEncodingApplicable(encoding, n_states)) {
+            settings.push_back({ false, use_minimal, encoding });
+        }
+    }
+
+    // configurations are constructed concurrently, so share the threads among them
+    const int total_threads = num_threads > 0 ? num_threads : std::max(1u, std::thread::hardware_concurrency());
+    const int conf_threads = std::max<int>(1, total_threads / settings.size());
+
+    std::vector<std::shared_ptr<AigerConstructor>> configurations;
+    configurations.reserve(settings.size());
+    // all configurations start from the same order of the inputs
+    const std::vector<var_t> input_order = computeInputOrder(m);
+    for (const auto& setting : settings) {
+        std::shared_ptr<AigerConstructor> conf(new AigerConstructor(m,
+                    std::get<0>(setting), std::get<1>(setting), conf_threads, std::get<2>(setting)));
+        conf->setInputOrder(input_order);
+        conf->setReorderingBudget(reordering_budget);
+        configurations.push_back(conf);
     }
-    configurations.push_back(std::shared_ptr<AigerConstructor>(new AigerConstructor(m, false, false)));
 
     std::vector<std::thread> threads;
     for (const auto& conf : configurations) {
@@ -571,7 +921,21 @@ std::shared_ptr<AigerConstructor> AigerConstructor::findMinimalAiger(const mealy
         min = std::min(min, conf->size());
     }
 
-    if (compress) {
+    if (compress && parallel_compression) {
+        // the ABC library is not thread-safe, so compress each circuit in its own process
+        std::vector<std::shared_ptr<AigerConstructor>> compressed_configurations;
+        for (const auto& conf : configurations) {
+            if (std::get<0>(min) >= std::get<0>(conf->size()) / 10) {
+                // avoid time-consuming compression of huge circuits if there is already a much smaller solution
+                compressed_configurations.push_back(conf);
+            }
+        }
+        compressInProcesses(compressed_configurations, compression_timeout);
+        for (const auto& conf : configurations) {
+            min = std::min(min, conf->size());
+        }
+    }
+    else if (compress) {
         // unfortunately the ABC library is not thread-safe, need to do compression sequentially
         Abc_Start();
         Abc_Frame_t* pAbc = Abc_FrameGetGlobalFrame();
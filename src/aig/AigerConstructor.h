@@ -3,6 +3,7 @@
 #include <iostream>
 #include <fstream>
 #include <unordered_map>
+#include <chrono>
 
 #include "cuddObj.hh"
 #include "cuddInt.h"
@@ -16,36 +17,13 @@ extern "C" {
 
 #include "mealy/MealyMachine.h"
 #include "util/SpecSeq.h"
+#include "StateEncoding.h"
+#include "AigBuilder.h"
 
 namespace aig {
     typedef std::vector<std::vector<mealy::Transition> > transition_vec;
-
-    typedef uint64_t literal_t;
-    typedef uint32_t var_t;
-
-    struct literal_pair_t {
-        literal_t lhs;
-        literal_t rhs;
-        literal_pair_t(const literal_t lhs, const literal_t rhs) :
-            lhs(lhs), rhs(rhs)
-        {}
-
-        bool operator==(const literal_pair_t& other) const {
-            return lhs == other.lhs && rhs == other.rhs;
-        }
-    };
 }
 
-template <>
-struct std::hash<aig::literal_pair_t> {
-    std::size_t operator()(const aig::literal_pair_t& pair) const {
-        std::size_t seed = 0;
-        boost::hash_combine(seed, pair.lhs);
-        boost::hash_combine(seed, pair.rhs);
-        return seed;
-    }
-};
-
 namespace aig {
     class AigerConstructor {
         private:
@@ -54,21 +32,42 @@ namespace aig {
             const mealy::MealyMachine& m;
             const bool use_labels;
             const bool minimize;
+            const StateEncoding encoding;
 
             aiger* aig;
             size_t n_states;
             size_t n_latches;
-            size_t and_gate_index;
+            const int threads;
+
+            // latch values of each state as successor and as current state
+            std::vector<SpecSeq<letter_t>> state_codes;
+            std::vector<SpecSeq<letter_t>> current_state_codes;
+
+            // initial order of the input variables and time limit for reordering
+            std::vector<var_t> input_order;
+            std::chrono::duration<double> reordering_budget;
 
             Cudd manager;
             std::vector<BDD> bdds;
 
+            Cudd createManager() const;
+            void reorder();
+
+            // cubes of a transition in some manager with the bits it determines
+            struct TransitionCube {
+                BDD state_cube;
+                BDD cube;
+                SpecSeq<letter_t> output;
+                SpecSeq<letter_t> next_state;
+                bool first;
+            };
+
             void constructBDDs();
-            BDD constructBDDForVar(const var_t var,
-                    const transition_vec& transitions);
-            literal_t nodeToLiteral(DdNode* node,
+            std::vector<TransitionCube> constructTransitionCubes(const Cudd& cudd, const transition_vec& machine) const;
+            BDD constructBDDForVar(const Cudd& cudd, var_t var, const std::vector<TransitionCube>& cubes) const;
+            literal_t nodeToLiteral(DdNode* root,
                     std::unordered_map<DdNode*, literal_t>& bdd_cache,
-                    std::unordered_map<literal_pair_t, literal_t>& aig_cache);
+                    AigBuilder& builder) const;
 
             inline literal_t input2lit(const var_t input_var) const {
                 return aiger_var2lit(1 + input_var);
@@ -86,8 +85,6 @@ namespace aig {
                 return aiger_var2lit(1 + var);
             }
 
-            literal_t add_and(literal_t lhs, literal_t rhs, std::unordered_map<literal_pair_t, literal_t>& aig_cache);
-
             void executeAbcCommand(Abc_Frame_t* pAbc, const std::string command) const;
             void executeCompressCommands(Abc_Frame_t* pAbc) const;
             int getAbcNetworkSize(Abc_Frame_t* pAbc) const;
@@ -95,14 +92,39 @@ namespace aig {
             void constructAiger(const bool keepBDDs);
             void compressAiger(Abc_Frame_t* pAbc);
 
-            int getTmpFile(char* tmp_filename) const;
+            // direct conversion between the circuit and a strashed ABC network
+            Abc_Ntk_t* toAbcNetwork() const;
+            void fromAbcNetwork(Abc_Ntk_t* pNtk);
             void writeToAbc(Abc_Frame_t* pAbc) const;
             void readFromAbc(Abc_Frame_t* pAbc);
 
+            static void compressInProcesses(const std::vector<std::shared_ptr<AigerConstructor>>& configurations, const std::chrono::duration<double> timeout);
+
         public:
-            AigerConstructor(const mealy::MealyMachine& m, const bool use_labels, const bool minimize);
+            /*
+             * With more than one thread (or 0 for all cores), the BDDs for the outputs and
+             * latches are constructed in parallel in separate managers.
+             * The encoding is used for the states if labels are not used.
+             */
+            AigerConstructor(const mealy::MealyMachine& m, const bool use_labels, const bool minimize, const int threads = 1,
+                    const StateEncoding encoding = StateEncoding::BINARY);
             ~AigerConstructor();
 
+            /*
+             * Seeds the variable order of the BDDs with the given order of inputs,
+             * interleaved with the latches, instead of the order of declaration.
+             */
+            void setInputOrder(std::vector<var_t> order);
+            /*
+             * Limits the time for reordering the BDDs before the circuit is constructed,
+             * where exact reordering is replaced by sifting passes that stop once the
+             * time limit is reached. A zero duration means no limit.
+             */
+            void setReorderingBudget(const std::chrono::duration<double> budget);
+
+            // order of the inputs by the number of transitions that depend on them
+            static std::vector<var_t> computeInputOrder(const mealy::MealyMachine& m);
+
             void construct(const bool compress, const bool keepBDDs);
             void print_aiger(std::ostream& out, const bool binary = false) const;
             void print_dot(std::ostream& out) const;
@@ -117,6 +139,17 @@ namespace aig {
                 return std::tuple<literal_t,literal_t>(num_ands(), num_latches());
             }
 
-            static std::shared_ptr<AigerConstructor> findMinimalAiger(const mealy::MealyMachine& m, const bool use_labels, const bool use_minimal, const bool compress, const bool keepBDDs);
+            /*
+             * Constructs circuits for several configurations, including different state
+             * encodings for the machine without labels, and returns the smallest one.
+             * With parallel compression, the circuits are compressed concurrently in forked
+             * processes, as ABC is not thread-safe, and circuits whose compression does not
+             * finish within the timeout are used uncompressed. The timeout has to be positive,
+             * as a process forked from the multi-threaded parent may deadlock, e.g. if another
+             * thread held the lock of the allocator at the time of the fork.
+             */
+            static std::shared_ptr<AigerConstructor> findMinimalAiger(const mealy::MealyMachine& m, const bool use_labels, const bool use_minimal, const bool compress, const bool keepBDDs,
+                    const bool parallel_compression = false, const std::chrono::duration<double> compression_timeout = std::chrono::duration<double>(300),
+                    const int num_threads = 1, const std::chrono::duration<double> reordering_budget = std::chrono::duration<double>(0));
     };
 }
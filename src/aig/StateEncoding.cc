@@ -0,0 +1,179 @@
+#include "StateEncoding.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace aig {
+
+// the clustered encoding compares all pairs of states and codes
+constexpr mealy::state_id_t MAX_CLUSTERED_STATES = 256;
+
+static size_t numberOfBits(const mealy::state_id_t n_states) {
+    return n_states <= 1 ? 0 : (size_t)ceil(log2(n_states));
+}
+
+bool isEncodingApplicable(const StateEncoding encoding, const mealy::state_id_t n_states) {
+    switch (encoding) {
+        case StateEncoding::ONE_HOT:
+            return numberOfLatches(encoding, n_states) <= LETTER_BITS;
+        case StateEncoding::CLUSTERED:
+            return n_states <= MAX_CLUSTERED_STATES;
+        default:
+            return true;
+    }
+}
+
+size_t numberOfLatches(const StateEncoding encoding, const mealy::state_id_t n_states) {
+    if (encoding == StateEncoding::ONE_HOT) {
+        return n_states <= 1 ? 0 : n_states - 1;
+    }
+    else {
+        return numberOfBits(n_states);
+    }
+}
+
+// affinity of each pair of states, where states get a higher weight for each
+// pair of transitions with overlapping inputs that lead to the same successor
+// or have the same outputs, and successors of the same state get a weight
+// for each pair of transitions with the same outputs
+static std::vector<unsigned> computeAffinities(const mealy::machine_t& machine) {
+    const mealy::state_id_t n_states = machine.size();
+    std::vector<unsigned> weights(n_states * n_states, 0);
+    const auto addWeight = [&](const mealy::state_id_t s1, const mealy::state_id_t s2, const unsigned weight) {
+        if (s1 != s2) {
+            weights[s1 * n_states + s2] += weight;
+            weights[s2 * n_states + s1] += weight;
+        }
+    };
+
+    for (mealy::state_id_t s1 = 0; s1 < n_states; s1++) {
+        for (mealy::state_id_t s2 = s1 + 1; s2 < n_states; s2++) {
+            for (const mealy::Transition& t1 : machine[s1]) {
+                for (const mealy::Transition& t2 : machine[s2]) {
+                    if (t1.input.isCompatible(t2.input)) {
+                        if (t1.nextState == t2.nextState) {
+                            addWeight(s1, s2, 2);
+                        }
+                        if (t1.output == t2.output) {
+                            addWeight(s1, s2, 1);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    for (mealy::state_id_t s = 0; s < n_states; s++) {
+        for (size_t i = 0; i < machine[s].size(); i++) {
+            for (size_t j = i + 1; j < machine[s].size(); j++) {
+                if (machine[s][i].output == machine[s][j].output) {
+                    addWeight(machine[s][i].nextState, machine[s][j].nextState, 1);
+                }
+            }
+        }
+    }
+    return weights;
+}
+
+// places the states one after another on the free code that minimizes the
+// weighted Hamming distance to the codes of the already placed states,
+// starting with state 0 on code 0 and taking the state with highest affinity
+// to the placed states next
+static std::vector<uint64_t> clusteredCodes(const mealy::machine_t& machine) {
+    const mealy::state_id_t n_states = machine.size();
+    const uint64_t n_codes = (uint64_t)1 << numberOfBits(n_states);
+    const std::vector<unsigned> weights = computeAffinities(machine);
+
+    std::vector<uint64_t> codes(n_states, 0);
+    std::vector<bool> placed(n_states, false);
+    std::vector<bool> used(n_codes, false);
+    std::vector<unsigned> placed_affinity(n_states, 0);
+    std::vector<mealy::state_id_t> placed_states;
+
+    mealy::state_id_t next = 0;
+    for (mealy::state_id_t k = 0; k < n_states; k++) {
+        const mealy::state_id_t s = next;
+        uint64_t best_code = 0;
+        if (k > 0) {
+            unsigned long best_cost = std::numeric_limits<unsigned long>::max();
+            for (uint64_t code = 0; code < n_codes; code++) {
+                if (used[code]) {
+                    continue;
+                }
+                unsigned long cost = 0;
+                for (const mealy::state_id_t p : placed_states) {
+                    cost += (unsigned long)weights[s * n_states + p] * popcount(code ^ codes[p]);
+                }
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    best_code = code;
+                }
+            }
+        }
+        codes[s] = best_code;
+        used[best_code] = true;
+        placed[s] = true;
+        placed_states.push_back(s);
+
+        bool found = false;
+        for (mealy::state_id_t t = 0; t < n_states; t++) {
+            if (!placed[t]) {
+                placed_affinity[t] += weights[s * n_states + t];
+                if (!found || placed_affinity[t] > placed_affinity[next]) {
+                    next = t;
+                    found = true;
+                }
+            }
+        }
+    }
+    return codes;
+}
+
+std::vector<SpecSeq<letter_t>> encodeStates(const StateEncoding encoding, const mealy::machine_t& machine) {
+    const mealy::state_id_t n_states = machine.size();
+    if (!isEncodingApplicable(encoding, n_states)) {
+        throw std::invalid_argument("State encoding not applicable for " + std::to_string(n_states) + " states");
+    }
+
+    std::vector<SpecSeq<letter_t>> codes;
+    codes.reserve(n_states);
+    switch (encoding) {
+        case StateEncoding::BINARY:
+            for (mealy::state_id_t s = 0; s < n_states; s++) {
+                codes.push_back(SpecSeq<letter_t>(s));
+            }
+            break;
+        case StateEncoding::GRAY:
+            for (mealy::state_id_t s = 0; s < n_states; s++) {
+                codes.push_back(SpecSeq<letter_t>(s ^ (s >> 1)));
+            }
+            break;
+        case StateEncoding::ONE_HOT:
+            codes.push_back(SpecSeq<letter_t>(0));
+            for (mealy::state_id_t s = 1; s < n_states; s++) {
+                codes.push_back(SpecSeq<letter_t>((letter_t)1 << (s - 1)));
+            }
+            break;
+        case StateEncoding::CLUSTERED:
+            for (const uint64_t code : clusteredCodes(machine)) {
+                codes.push_back(SpecSeq<letter_t>(code));
+            }
+            break;
+    }
+    return codes;
+}
+
+std::vector<SpecSeq<letter_t>> currentStateCodes(const StateEncoding encoding, const std::vector<SpecSeq<letter_t>>& codes) {
+    std::vector<SpecSeq<letter_t>> current_codes(codes);
+    if (encoding == StateEncoding::ONE_HOT) {
+        // only the latch of the state itself is needed, except for state 0
+        const size_t n_latches = numberOfLatches(encoding, codes.size());
+        const letter_t mask = low_bits_mask<letter_t>(n_latches);
+        for (size_t s = 1; s < codes.size(); s++) {
+            current_codes[s].unspecifiedBits = mask & ~codes[s].number;
+        }
+    }
+    return current_codes;
+}
+
+}
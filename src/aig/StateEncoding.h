@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+
+#include "Definitions.h"
+#include "mealy/memin/Machine.h"
+#include "util/SpecSeq.h"
+
+namespace aig {
+
+/*
+ * Assignments of latch values to the states of a Mealy machine, where
+ * state 0 is always assigned the all-zero code as initial latch values.
+ *  - binary: the state number
+ *  - gray: the Gray code of the state number
+ *  - one-hot: one latch per state except state 0
+ *  - clustered: codes of log2(n) bits placed greedily such that states with
+ *    common successors or outputs under the same inputs get codes with small
+ *    Hamming distance, similar to the fanin/fanout heuristics of JEDI
+ */
+enum class StateEncoding { BINARY, GRAY, ONE_HOT, CLUSTERED };
+
+// whether the encoding is available for a machine with this number of states
+bool isEncodingApplicable(const StateEncoding encoding, const mealy::state_id_t n_states);
+
+size_t numberOfLatches(const StateEncoding encoding, const mealy::state_id_t n_states);
+
+std::vector<SpecSeq<letter_t>> encodeStates(const StateEncoding encoding, const mealy::machine_t& machine);
+
+// codes to recognize the current state, which leave latches unspecified that
+// are not needed to distinguish the state from other reachable latch values
+std::vector<SpecSeq<letter_t>> currentStateCodes(const StateEncoding encoding, const std::vector<SpecSeq<letter_t>>& codes);
+
+}
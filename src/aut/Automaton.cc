@@ -3,6 +3,8 @@
 #include <iostream>
 #include <algorithm>
 
+#include "util/Statistics.h"
+
 namespace aut {
 
 Automaton::Automaton(owl::Automaton _automaton) :
@@ -20,9 +22,9 @@ Automaton::Automaton(owl::Automaton _automaton) :
     successors.reserve(4096);
 }
 
-void Automaton::setAlphabetSize(const letter_t _alphabet_size) {
+void Automaton::setAlphabetSize(const size_t _alphabet_size) {
     alphabet_size = _alphabet_size;
-    max_number_successors = ((letter_t)1 << alphabet_size);
+    max_number_successors = alphabet_size <= 4 ? ((uint64_t)1 << alphabet_size) : 0;
 }
 
 color_t Automaton::initMaxColor() const {
@@ -141,10 +143,18 @@ void Automaton::add_successors(node_id_t local_state) {
         */
     }
 
+    static Statistics::Counter& cache_hits = Statistics::counter("automaton.successor_cache_hits");
+    static Statistics::Counter& cache_misses = Statistics::counter("automaton.successor_cache_misses");
+    static Statistics::Timer& jni_edges = Statistics::timer("jni.edges");
+    static Statistics::Counter& jni_quality_score = Statistics::counter("jni.quality_score");
+
     std::vector<int32_t>& tree = successors[local_state].tree;
     std::vector<ScoredEdge>& leaves = successors[local_state].leaves;
     if (leaves.empty()) {
+        cache_misses.add();
+        const auto start_time = std::chrono::steady_clock::now();
         owl::EdgeTree edge_tree = automaton.edges(local_state);
+        jni_edges.add(std::chrono::steady_clock::now() - start_time);
         const size_t offset = edge_tree.tree[0];
         const size_t edge_tree_size = edge_tree.tree.size();
         const size_t tree_size = offset - 1;
@@ -188,6 +198,7 @@ void Automaton::add_successors(node_id_t local_state) {
             else {
                 successor_state = state;
                 score = automaton.quality_score(state, color);
+                jni_quality_score.add();
                 if (node_type == NodeType::WEAK) {
                     color = default_color;
                 }
@@ -217,6 +228,9 @@ void Automaton::add_successors(node_id_t local_state) {
 
         //new_successors.notify_all();
     }
+    else {
+        cache_hits.add();
+    }
 }
 
 ScoredEdge Automaton::getSuccessor(node_id_t local_state, letter_t letter) {
@@ -40,7 +40,7 @@ class Automaton {
                 int32_t i = 0;
                 if (!tree.empty()) {
                     do {
-                        if ((letter & ((letter_t)1 << tree[i])) == 0) {
+                        if (!test_letter_bit(letter, tree[i])) {
                             i = tree[i + 1];
                         } else {
                             i = tree[i + 2];
@@ -51,8 +51,9 @@ class Automaton {
                 return leaves[-i];
             }
 
+            // only used for small alphabets, where the letter fits into one word
             inline ScoredEdge direct_lookup(const letter_t letter) const {
-                return direct[letter];
+                return direct[static_cast<uint64_t>(letter)];
             }
 
             inline ScoredEdge lookup(const letter_t letter) const {
@@ -64,9 +65,9 @@ class Automaton {
                 }
             }
 
-            void flatten_tree(const letter_t max_letter) {
+            void flatten_tree(const uint64_t max_letter) {
                 direct.reserve(max_letter);
-                for (letter_t letter = 0; letter < max_letter; letter++) {
+                for (uint64_t letter = 0; letter < max_letter; letter++) {
                     direct.push_back(tree_lookup(letter));
                 }
             }
@@ -78,8 +79,8 @@ class Automaton {
         const color_t default_color;
         const Parity parity_type;
         std::vector< SuccessorCache > successors;
-        letter_t alphabet_size;
-        letter_t max_number_successors;
+        size_t alphabet_size;
+        uint64_t max_number_successors;
 
         // queue for querying for successors
         std::queue<node_id_t> queries;
@@ -117,7 +118,7 @@ class Automaton {
     public:
         Automaton(owl::Automaton automaton);
 
-        void setAlphabetSize(const letter_t alphabet_size);
+        void setAlphabetSize(const size_t alphabet_size);
 
         ScoredEdge getSuccessor(node_id_t local_state, letter_t letter);
 
@@ -173,6 +173,15 @@ class AutomatonTreeStructure {
         std::vector<size_t> leaf_state_indices;
         product_state_t initial_state;
 
+        // winners of automaton states already declared to or determined by owl,
+        // which is only a shortcut for owl and cleared when it reaches the maximum size
+        static constexpr size_t MAX_KNOWN_WINNERS = 1 << 20;
+        std::map<std::vector<jint>, Player> known_winners;
+
+        bool insertKnownWinner(std::vector<jint> automaton_states, const Player winner);
+        bool declareWinning(std::vector<jint> automaton_states, const Player winner);
+        Player queryWinner(std::vector<jint> automaton_states);
+
     public:
         AutomatonTreeStructure(owl::DecomposedDPA automaton);
         ~AutomatonTreeStructure();
@@ -187,6 +196,12 @@ class AutomatonTreeStructure {
         bool declareWinning(const product_state_t& state, const Player winner);
         Player queryWinner(const product_state_t& state);
 
+        // versions for several states, which pass each distinct combination of automaton
+        // states with a yet unknown winner to owl once,
+        // returns the number of declarations that added new information
+        size_t declareWinning(const std::vector<std::pair<const product_state_t*, Player>>& states);
+        void queryWinner(const std::vector<const product_state_t*>& states, std::vector<Player>& winners);
+
         bool isTopState(const product_state_t& state) const;
         bool isBottomState(const product_state_t& state) const;
 
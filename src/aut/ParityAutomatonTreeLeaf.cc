@@ -42,7 +42,7 @@ ColorScore ParityAutomatonTreeLeaf::getSuccessor(const product_state_t& state, p
     letter_t new_letter = 0;
 
     for (const auto& map : reference.alphabet_mapping) {
-        new_letter |= ((letter & ((letter_t)1 << map.first)) >> map.first) << map.second;
+        new_letter |= (letter_t)test_letter_bit(letter, map.first) << map.second;
     }
 
     ScoredEdge edge = automaton.getSuccessor(local_state, new_letter);
@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <cmath>
 
+#include "util/Statistics.h"
+
 namespace aut {
 
 bool cmp_trees(const std::unique_ptr<ParityAutomatonTree>& t1, const std::unique_ptr<ParityAutomatonTree>& t2) {
@@ -259,8 +261,24 @@ std::vector<jint> AutomatonTreeStructure::getAutomatonStates(const product_state
     return automaton_states;
 }
 
-bool AutomatonTreeStructure::declareWinning(const product_state_t& state, const Player winner) {
-    std::vector<jint> automaton_states = getAutomatonStates(state);
+bool AutomatonTreeStructure::insertKnownWinner(std::vector<jint> automaton_states, const Player winner) {
+    if (known_winners.size() >= MAX_KNOWN_WINNERS && known_winners.find(automaton_states) == known_winners.end()) {
+        // owl keeps all declarations, so forgetting them only costs repeated calls
+        std::map<std::vector<jint>, Player>().swap(known_winners);
+    }
+    return known_winners.insert({ std::move(automaton_states), winner }).second;
+}
+
+bool AutomatonTreeStructure::declareWinning(std::vector<jint> automaton_states, const Player winner) {
+    if (winner == Player::UNKNOWN) {
+        return false;
+    }
+    if (!insertKnownWinner(automaton_states, winner)) {
+        // already declared or queried
+        return false;
+    }
+    static Statistics::Timer& jni_declare = Statistics::timer("jni.declare");
+    Statistics::ScopedTimer timer(jni_declare);
     switch (winner) {
         case Player::SYS_PLAYER:
             return owl_automaton.declare(owl::RealizabilityStatus::REALIZABLE, std::move(automaton_states));
@@ -271,16 +289,71 @@ bool AutomatonTreeStructure::declareWinning(const product_state_t& state, const
     }
 }
 
-Player AutomatonTreeStructure::queryWinner(const product_state_t& state) {
-    std::vector<jint> automaton_states = getAutomatonStates(state);
-    owl::RealizabilityStatus status = owl_automaton.query(std::move(automaton_states));
+Player AutomatonTreeStructure::queryWinner(std::vector<jint> automaton_states) {
+    static Statistics::Counter& winner_cache_hits = Statistics::counter("automaton.winner_cache_hits");
+    static Statistics::Timer& jni_query = Statistics::timer("jni.query");
+
+    auto it = known_winners.find(automaton_states);
+    if (it != known_winners.end()) {
+        winner_cache_hits.add();
+        return it->second;
+    }
+    Player winner;
+    const auto start_time = std::chrono::steady_clock::now();
+    owl::RealizabilityStatus status = owl_automaton.query(automaton_states);
+    jni_query.add(std::chrono::steady_clock::now() - start_time);
     switch (status) {
         case owl::RealizabilityStatus::REALIZABLE:
-            return Player::SYS_PLAYER;
+            winner = Player::SYS_PLAYER;
+            break;
         case owl::RealizabilityStatus::UNREALIZABLE:
-            return Player::ENV_PLAYER;
+            winner = Player::ENV_PLAYER;
+            break;
         default:
-            return Player::UNKNOWN;
+            winner = Player::UNKNOWN;
+            break;
+    }
+    // only definite answers are stable and can be cached
+    if (winner != Player::UNKNOWN) {
+        insertKnownWinner(std::move(automaton_states), winner);
+    }
+    return winner;
+}
+
+bool AutomatonTreeStructure::declareWinning(const product_state_t& state, const Player winner) {
+    return declareWinning(getAutomatonStates(state), winner);
+}
+
+Player AutomatonTreeStructure::queryWinner(const product_state_t& state) {
+    return queryWinner(getAutomatonStates(state));
+}
+
+size_t AutomatonTreeStructure::declareWinning(const std::vector<std::pair<const product_state_t*, Player>>& states) {
+    size_t declared = 0;
+    for (const auto& state_winner : states) {
+        if (declareWinning(getAutomatonStates(*state_winner.first), state_winner.second)) {
+            declared++;
+        }
+    }
+    return declared;
+}
+
+void AutomatonTreeStructure::queryWinner(const std::vector<const product_state_t*>& states, std::vector<Player>& winners) {
+    winners.clear();
+    winners.reserve(states.size());
+    // several product states may map to the same automaton states, query each only once
+    std::map<std::vector<jint>, Player> queried;
+    for (const product_state_t* state : states) {
+        std::vector<jint> automaton_states = getAutomatonStates(*state);
+        auto it = queried.find(automaton_states);
+        if (it != queried.end()) {
+            winners.push_back(it->second);
+        }
+        else {
+            const Player winner = queryWinner(automaton_states);
+            queried.insert({ std::move(automaton_states), winner });
+            winners.push_back(winner);
+        }
     }
 }
 
@@ -305,6 +378,7 @@ void AutomatonTreeStructure::clear() {
     // free memory from automata and tree
     std::deque<Automaton>().swap(automata);
     tree.reset();
+    std::map<std::vector<jint>, Player>().swap(known_winners);
 }
 
 void AutomatonTreeStructure::print(const int verbosity) const {
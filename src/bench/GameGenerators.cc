@@ -0,0 +1,96 @@
+#include "GameGenerators.h"
+
+#include <random>
+
+namespace bench {
+
+ParityGame::ParityGame(const node_id_t n_nodes) {
+    priorities.reserve(n_nodes);
+    owners.reserve(n_nodes);
+    succs_begin.reserve(n_nodes + 1);
+    succs_begin.push_back(0);
+}
+
+void ParityGame::addNode(const uint32_t priority, const uint8_t owner, const std::vector<node_id_t>& successors) {
+    priorities.push_back(priority);
+    owners.push_back(owner);
+    succs.insert(succs.end(), successors.cbegin(), successors.cend());
+    succs_begin.push_back(succs.size());
+}
+
+std::unique_ptr<pg::PGArena> ParityGame::toArena() const {
+    return pg::PGArena::fromParityGame(priorities, owners, succs_begin, succs, 0);
+}
+
+ParityGame random_game(const node_id_t n_nodes, const uint32_t n_colors, const node_id_t degree, const unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<uint32_t> priority_distribution(0, n_colors - 1);
+    std::uniform_int_distribution<node_id_t> node_distribution(0, n_nodes - 1);
+    std::bernoulli_distribution owner_distribution;
+
+    ParityGame game(n_nodes);
+    std::vector<node_id_t> successors(degree);
+    for (node_id_t i = 0; i < n_nodes; i++) {
+        for (node_id_t& succ : successors) {
+            succ = node_distribution(generator);
+        }
+        game.addNode(priority_distribution(generator), owner_distribution(generator), successors);
+    }
+    return game;
+}
+
+ParityGame ladder_game(const node_id_t n_nodes, const uint32_t n_colors) {
+    // round up to complete rungs
+    const node_id_t n_rungs = (n_nodes + 1) / 2;
+
+    ParityGame game(2 * n_rungs);
+    for (node_id_t i = 0; i < 2 * n_rungs; i++) {
+        const node_id_t next_rung = 2 * ((i / 2 + 1) % n_rungs);
+        game.addNode(i % n_colors, i % 2, { next_rung, next_rung + 1 });
+    }
+    return game;
+}
+
+ParityGame clique_game(const node_id_t n_nodes, const uint32_t n_colors) {
+    ParityGame game(n_nodes);
+    std::vector<node_id_t> successors;
+    for (node_id_t i = 0; i < n_nodes; i++) {
+        successors.clear();
+        for (node_id_t j = 0; j < n_nodes; j++) {
+            if (i != j) {
+                successors.push_back(j);
+            }
+        }
+        game.addNode(i % n_colors, i % 2, successors);
+    }
+    return game;
+}
+
+ParityGame jurdzinski_game(const node_id_t levels, const node_id_t width) {
+    // block j of level i has odd node 2 * (i * width + j) and even node 2 * (i * width + j) + 1
+    auto odd_node = [&](const node_id_t i, const node_id_t j) { return 2 * (i * width + j); };
+    auto even_node = [&](const node_id_t i, const node_id_t j) { return 2 * (i * width + j) + 1; };
+
+    ParityGame game(2 * levels * width);
+    std::vector<node_id_t> successors;
+    for (node_id_t i = 0; i < levels; i++) {
+        for (node_id_t j = 0; j < width; j++) {
+            // player 1 may stay in the block, or escape to a lower level
+            successors = { even_node(i, j) };
+            if (i > 0) {
+                successors.push_back(even_node(i - 1, j));
+            }
+            game.addNode(2 * i + 1, 1, successors);
+
+            // player 0 may stay in the block, advance along the cycle of the level, or move to a higher level
+            successors = { odd_node(i, j), odd_node(i, (j + 1) % width) };
+            if (i + 1 < levels) {
+                successors.push_back(odd_node(i + 1, j));
+            }
+            game.addNode(2 * i + 2, 0, successors);
+        }
+    }
+    return game;
+}
+
+}
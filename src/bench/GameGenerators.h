@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Definitions.h"
+#include "pg/PGArena.h"
+
+namespace bench {
+
+/*
+ * Synthetic parity games for benchmarking the solver, in PGSolver semantics:
+ * player 0 owns nodes with owner 0 and wins if the highest priority seen
+ * infinitely often is even.
+ */
+struct ParityGame {
+    std::vector<uint32_t> priorities;
+    std::vector<uint8_t> owners;
+    std::vector<edge_id_t> succs_begin;
+    std::vector<node_id_t> succs;
+
+    ParityGame(const node_id_t n_nodes);
+
+    inline node_id_t numberOfNodes() const { return priorities.size(); }
+    inline edge_id_t numberOfEdges() const { return succs.size(); }
+
+    // nodes have to be added in order of their ids
+    void addNode(const uint32_t priority, const uint8_t owner, const std::vector<node_id_t>& successors);
+
+    std::unique_ptr<pg::PGArena> toArena() const;
+};
+
+// nodes with random priority and owner, each with the given number of random successors
+ParityGame random_game(const node_id_t n_nodes, const uint32_t n_colors, const node_id_t degree, const unsigned seed);
+
+// chain of rungs of two nodes, where both nodes of a rung move to both nodes of the next rung
+ParityGame ladder_game(const node_id_t n_nodes, const uint32_t n_colors);
+
+// complete graph without self loops
+ParityGame clique_game(const node_id_t n_nodes, const uint32_t n_colors);
+
+// layered games in the style of Jurdziński, with the given number of levels,
+// each consisting of a cycle of blocks with an odd and an even node,
+// which require long distance vectors in the solver
+ParityGame jurdzinski_game(const node_id_t levels, const node_id_t width);
+
+}
@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+
+#include <functional>
+#include <random>
+
+#include "Definitions.h"
+#include "QuineReference.h"
+#include "util/Quine.h"
+
+/*
+ * Micro-benchmarks of the computation of prime implicants with the flat
+ * QuineTable and with the previous table of nested hash maps, on random
+ * functions given as sets of minterms. The number of threads of the merge
+ * passes can be set with OMP_NUM_THREADS.
+ */
+
+namespace {
+
+using ImplicantFunction = std::function<std::vector<SpecSeq<letter_t>>(const int, const std::vector<SpecSeq<letter_t>>&)>;
+
+// minterms of a random function, each with the given probability in percent
+std::vector<SpecSeq<letter_t>> random_minterms(const int num_bits, const int percent, const unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> distribution(0, 99);
+    std::vector<SpecSeq<letter_t>> minterms;
+    for (uint64_t m = 0; m < ((uint64_t)1 << num_bits); m++) {
+        if (distribution(generator) < percent) {
+            minterms.push_back(SpecSeq<letter_t>(m, 0));
+        }
+    }
+    return minterms;
+}
+
+void compute_implicants(benchmark::State& state, const ImplicantFunction& function) {
+    const int num_bits = state.range(0);
+    const std::vector<SpecSeq<letter_t>> minterms = random_minterms(num_bits, state.range(1), 42);
+
+    size_t n_implicants = 0;
+    for (auto _ : state) {
+        const std::vector<SpecSeq<letter_t>> implicants = function(num_bits, minterms);
+        n_implicants = implicants.size();
+        benchmark::DoNotOptimize(implicants.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * minterms.size());
+    state.counters["minterms"] = minterms.size();
+    state.counters["implicants"] = n_implicants;
+}
+
+// arguments: variables, percentage of minterms
+void BM_PrimeImplicants(benchmark::State& state) {
+    compute_implicants(state, quine_prime_implicants<letter_t>);
+}
+BENCHMARK(BM_PrimeImplicants)
+    ->ArgNames({ "variables", "percent" })
+    ->ArgsProduct({ { 8, 12, 16, 20 }, { 5, 30 } })
+    ->Unit(benchmark::kMillisecond);
+
+// the previous implementation is too slow for 20 variables
+void BM_ReferencePrimeImplicants(benchmark::State& state) {
+    compute_implicants(state, bench::reference_quine_prime_implicants<letter_t>);
+}
+BENCHMARK(BM_ReferencePrimeImplicants)
+    ->ArgNames({ "variables", "percent" })
+    ->ArgsProduct({ { 8, 12, 16 }, { 5, 30 } })
+    ->Unit(benchmark::kMillisecond);
+
+void BM_PrimeImplicantCover(benchmark::State& state) {
+    compute_implicants(state, quine_prime_implicant_cover<letter_t>);
+}
+BENCHMARK(BM_PrimeImplicantCover)
+    ->ArgNames({ "variables", "percent" })
+    ->ArgsProduct({ { 8, 12, 16, 20 }, { 5, 30 } })
+    ->Unit(benchmark::kMillisecond);
+
+}
+
+BENCHMARK_MAIN();
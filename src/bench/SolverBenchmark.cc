@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <functional>
+
+#include "GameGenerators.h"
+#include "pg/PGSISolver.h"
+
+/*
+ * Micro-benchmarks of the parity game solver on synthetic arenas, which are
+ * constructed directly without a specification. Only solving is timed, and
+ * the time and throughput of each phase of the solver is reported as user
+ * counters, where throughput is given in traversed edges per second.
+ */
+
+namespace {
+
+using GameGenerator = std::function<bench::ParityGame(const benchmark::State&)>;
+
+void add_phase_counters(benchmark::State& state, const std::string& name, const pg::PhaseStatistics& stats) {
+    state.counters[name + "_time"] = benchmark::Counter(stats.time.count(), benchmark::Counter::kAvgIterations);
+    state.counters[name + "_runs"] = benchmark::Counter(stats.executions, benchmark::Counter::kAvgIterations);
+    state.counters[name + "_edges/s"] = benchmark::Counter(stats.time.count() > 0 ? stats.edges / stats.time.count() : 0);
+}
+
+void solve_game(benchmark::State& state, const GameGenerator& generator, const int threads) {
+    const bench::ParityGame game = generator(state);
+
+    pg::PhaseStatistics bellman_ford;
+    pg::PhaseStatistics strategy_improvement;
+    pg::PhaseStatistics update_nodes;
+    auto accumulate = [](pg::PhaseStatistics& total, const pg::PhaseStatistics& stats) {
+        total.time += stats.time;
+        total.executions += stats.executions;
+        total.edges += stats.edges;
+    };
+
+    size_t n_edges = 0;
+    for (auto _ : state) {
+        // the solver marks winning nodes in the arena, so every iteration needs a new one
+        std::unique_ptr<pg::PGArena> arena = game.toArena();
+        n_edges = arena->n_sys_edges + arena->n_env_edges;
+
+        pg::PGSISolver solver(*arena, false, threads);
+        const auto start_time = std::chrono::steady_clock::now();
+        solver.solve();
+        const std::chrono::duration<double> solve_time = std::chrono::steady_clock::now() - start_time;
+        state.SetIterationTime(solve_time.count());
+        benchmark::DoNotOptimize(solver.getWinner());
+
+        accumulate(bellman_ford, solver.getBellmanFordStatistics());
+        accumulate(strategy_improvement, solver.getStrategyImprovementStatistics());
+        accumulate(update_nodes, solver.getUpdateNodesStatistics());
+    }
+
+    state.SetItemsProcessed(bellman_ford.edges + strategy_improvement.edges + update_nodes.edges);
+    state.counters["nodes"] = game.numberOfNodes();
+    state.counters["arena_edges"] = n_edges;
+    add_phase_counters(state, "bellman_ford", bellman_ford);
+    add_phase_counters(state, "strategy_improvement", strategy_improvement);
+    add_phase_counters(state, "update_nodes", update_nodes);
+}
+
+// arguments: nodes, colors, degree, threads
+void BM_RandomGame(benchmark::State& state) {
+    solve_game(state, [](const benchmark::State& state) {
+        return bench::random_game(state.range(0), state.range(1), state.range(2), 42);
+    }, state.range(3));
+}
+BENCHMARK(BM_RandomGame)
+    ->ArgNames({ "nodes", "colors", "degree", "threads" })
+    ->ArgsProduct({ { 1 << 10, 1 << 13, 1 << 16 }, { 4, 16 }, { 4 }, { 1 } })
+    ->Args({ 1 << 16, 16, 4, 0 })
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+// arguments: nodes, colors
+void BM_LadderGame(benchmark::State& state) {
+    solve_game(state, [](const benchmark::State& state) {
+        return bench::ladder_game(state.range(0), state.range(1));
+    }, 1);
+}
+BENCHMARK(BM_LadderGame)
+    ->ArgNames({ "nodes", "colors" })
+    ->ArgsProduct({ { 1 << 10, 1 << 13, 1 << 16 }, { 2, 8 } })
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+// arguments: nodes, colors
+void BM_CliqueGame(benchmark::State& state) {
+    solve_game(state, [](const benchmark::State& state) {
+        return bench::clique_game(state.range(0), state.range(1));
+    }, 1);
+}
+BENCHMARK(BM_CliqueGame)
+    ->ArgNames({ "nodes", "colors" })
+    ->ArgsProduct({ { 64, 256, 1024 }, { 4, 64 } })
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+// arguments: levels, width
+void BM_JurdzinskiGame(benchmark::State& state) {
+    solve_game(state, [](const benchmark::State& state) {
+        return bench::jurdzinski_game(state.range(0), state.range(1));
+    }, 1);
+}
+BENCHMARK(BM_JurdzinskiGame)
+    ->ArgNames({ "levels", "width" })
+    ->ArgsProduct({ { 2, 4, 8 }, { 16, 128, 1024 } })
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+}
+
+BENCHMARK_MAIN();
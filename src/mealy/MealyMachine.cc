@@ -6,6 +6,9 @@
 #include <map>
 #include <algorithm>
 
+#include "util/Profiler.h"
+#include "util/Statistics.h"
+
 namespace mealy {
 
 void MealyMachine::setStateLabels(std::vector<SpecSeq<node_id_t>> labels, int bits, std::vector<int> accumulated_bits) {
@@ -27,18 +30,54 @@ void MealyMachine::setMachine(machine_t new_machine) {
     machine = std::move(new_machine);
 }
 
-void MealyMachine::minimizeMachine(const int verbosity) {
+void MealyMachine::minimizeMachine(const MinimizationOptions& options, const int verbosity) {
+    PROFILE_ZONE("minimizeMachine");
+
+    // merge equivalent states first, which is fast and makes the exact minimization smaller
+    machine_t quotient_machine;
+    std::vector<std::vector<state_id_t> > quotient_classes;
+    {
+        Statistics::ScopedTimer timer(Statistics::timer("mealy.partition_refinement"));
+        computeQuotientMachine(machine, quotient_machine, quotient_classes);
+    }
+    if (verbosity >= 1) {
+        std::cout << "Number of states after partition refinement: " << quotient_machine.size() << std::endl;
+    }
+
     std::vector<std::vector<state_id_t> > newStates;
 
     int result = 0;
-    try {
-        result = minimizeMachineMeMin(machine, 0, n_inputs, n_outputs, min_machine, newStates, verbosity);
+    if (quotient_machine.size() <= options.max_exact_states) {
+        try {
+            result = minimizeMachineMeMin(quotient_machine, 0, n_inputs, n_outputs, min_machine, newStates, options, verbosity);
+        }
+        catch (const std::bad_alloc& ex) {
+            if (verbosity >= 1) {
+                std::cerr << "Error: Minimization of Mealy machine failed due to insufficient memory." << std::endl;
+            }
+            min_machine.clear();
+        }
+    }
+    else if (verbosity >= 1) {
+        std::cout << "Skipping exact minimization of Mealy machine with " << quotient_machine.size() << " states" << std::endl;
     }
-    catch (const std::bad_alloc& ex) {
-        if (verbosity >= 1) {
-            std::cerr << "Error: Minimization of Mealy machine failed due to insufficient memory." << std::endl;
+
+    if (result == 1) {
+        // map the states of the quotient machine back to the original states
+        for (std::vector<state_id_t>& statesInClass : newStates) {
+            std::vector<state_id_t> originalStates;
+            for (const state_id_t quotientState : statesInClass) {
+                const std::vector<state_id_t>& quotientClass = quotient_classes[quotientState];
+                originalStates.insert(originalStates.end(), quotientClass.cbegin(), quotientClass.cend());
+            }
+            statesInClass = std::move(originalStates);
         }
-        min_machine.clear();
+    }
+    else if (quotient_machine.size() < machine.size()) {
+        // exact minimization failed or was skipped, fall back to the quotient machine
+        min_machine = std::move(quotient_machine);
+        newStates = std::move(quotient_classes);
+        result = 1;
     }
 
     if (result == 1) {
@@ -11,6 +11,7 @@
 #include "util/SpecSeq.h"
 #include "util/Quine.h"
 #include "memin/MeMin.h"
+#include "PartitionRefinement.h"
 
 namespace mealy {
 
@@ -66,7 +67,7 @@ public:
     void setStateLabels(std::vector<SpecSeq<node_id_t>> labels, const int bits, std::vector<int> accumulated_bits);
     SpecSeq<node_id_t> getStateLabel(const state_id_t s, const bool use_minimized = false) const;
 
-    void minimizeMachine(const int verbosity = 0);
+    void minimizeMachine(const MinimizationOptions& options = MinimizationOptions(), const int verbosity = 0);
     state_id_t numberOfStates() const;
     state_id_t numberOfMinStates() const;
     int getStateLabelBits() const;
@@ -0,0 +1,198 @@
+#include "PartitionRefinement.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+namespace mealy {
+
+// partition of the states, where each block is a contiguous range in the
+// array of elements and marked states are moved to the front of their block
+class RefinablePartition {
+private:
+    std::vector<state_id_t> elements;
+    std::vector<size_t> location;
+    std::vector<size_t> block_of;
+    std::vector<size_t> block_begin;
+    std::vector<size_t> block_end;
+    std::vector<size_t> block_marked_end;
+    std::vector<size_t> touched_blocks;
+
+public:
+    RefinablePartition(const std::vector<size_t>& initial_block, const size_t n_blocks) :
+        elements(initial_block.size()),
+        location(initial_block.size()),
+        block_of(initial_block),
+        block_begin(n_blocks + 1, 0),
+        block_end(n_blocks),
+        block_marked_end(n_blocks)
+    {
+        // counting sort of the states by their initial block
+        for (const size_t b : initial_block) {
+            block_begin[b + 1]++;
+        }
+        for (size_t b = 0; b < n_blocks; b++) {
+            block_begin[b + 1] += block_begin[b];
+            block_end[b] = block_begin[b];
+        }
+        block_begin.pop_back();
+        for (state_id_t s = 0; s < initial_block.size(); s++) {
+            const size_t i = block_end[initial_block[s]]++;
+            elements[i] = s;
+            location[s] = i;
+        }
+        block_marked_end = block_begin;
+    }
+
+    size_t numberOfBlocks() const { return block_begin.size(); }
+    size_t blockOf(const state_id_t s) const { return block_of[s]; }
+    std::vector<state_id_t> statesOf(const size_t b) const {
+        return std::vector<state_id_t>(elements.begin() + block_begin[b], elements.begin() + block_end[b]);
+    }
+
+    void mark(const state_id_t s) {
+        const size_t b = block_of[s];
+        const size_t i = location[s];
+        const size_t j = block_marked_end[b];
+        if (i < j) {
+            // already marked
+            return;
+        }
+        if (j == block_begin[b]) {
+            touched_blocks.push_back(b);
+        }
+        std::swap(elements[i], elements[j]);
+        location[elements[i]] = i;
+        location[elements[j]] = j;
+        block_marked_end[b]++;
+    }
+
+    // splits the touched blocks into marked and unmarked states, where the new block
+    // is always the smaller part, and returns the new blocks
+    void split(std::vector<size_t>& new_blocks) {
+        new_blocks.clear();
+        for (const size_t b : touched_blocks) {
+            const size_t begin = block_begin[b];
+            const size_t mid = block_marked_end[b];
+            const size_t end = block_end[b];
+            block_marked_end[b] = begin;
+            if (mid == end) {
+                continue;
+            }
+
+            const size_t new_block = block_begin.size();
+            if (mid - begin <= end - mid) {
+                block_begin.push_back(begin);
+                block_end.push_back(mid);
+                block_begin[b] = mid;
+            }
+            else {
+                block_begin.push_back(mid);
+                block_end.push_back(end);
+                block_end[b] = mid;
+            }
+            block_marked_end.push_back(block_begin[new_block]);
+            block_marked_end[b] = block_begin[b];
+            for (size_t i = block_begin[new_block]; i < block_end[new_block]; i++) {
+                block_of[elements[i]] = new_block;
+            }
+            new_blocks.push_back(new_block);
+        }
+        touched_blocks.clear();
+    }
+};
+
+void computeQuotientMachine(const machine_t& machine, machine_t& quotientMachine, std::vector<std::vector<state_id_t> >& classes) {
+    const state_id_t nStates = machine.size();
+
+    // number the distinct labels of transitions, consisting of input and outputs
+    std::map<std::pair<SpecSeq<letter_t>, std::vector<SpecSeq<letter_t>> >, size_t> labelIds;
+    // incoming transitions of each state as pairs of label and source
+    std::vector<size_t> incomingBegin(nStates + 1, 0);
+    std::vector<std::pair<size_t, state_id_t> > incoming;
+    // sorted labels of the outgoing transitions of each state
+    std::vector<std::vector<size_t> > stateLabels(nStates);
+
+    for (state_id_t s = 0; s < nStates; s++) {
+        for (const Transition& t : machine[s]) {
+            const auto result = labelIds.insert({ { t.input, t.output }, labelIds.size() });
+            stateLabels[s].push_back(result.first->second);
+            incomingBegin[t.nextState + 1]++;
+        }
+        std::sort(stateLabels[s].begin(), stateLabels[s].end());
+    }
+    for (state_id_t s = 0; s < nStates; s++) {
+        incomingBegin[s + 1] += incomingBegin[s];
+    }
+    incoming.resize(incomingBegin[nStates]);
+    std::vector<size_t> incomingEnd(incomingBegin.begin(), incomingBegin.end() - 1);
+    for (state_id_t s = 0; s < nStates; s++) {
+        for (const Transition& t : machine[s]) {
+            incoming[incomingEnd[t.nextState]++] = { labelIds.at({ t.input, t.output }), s };
+        }
+    }
+
+    // initial partition by the labels of the outgoing transitions, so that
+    // all states in a block have a transition for the same labels
+    std::map<std::vector<size_t>, size_t> initialBlockIds;
+    std::vector<size_t> initialBlock(nStates);
+    for (state_id_t s = 0; s < nStates; s++) {
+        initialBlock[s] = initialBlockIds.insert({ std::move(stateLabels[s]), initialBlockIds.size() }).first->second;
+    }
+    stateLabels.clear();
+
+    RefinablePartition partition(initialBlock, initialBlockIds.size());
+
+    // each block split off is used as splitter for all labels, and as it
+    // is the smaller part of the split, each transition is only scanned
+    // O(log n) times
+    std::vector<size_t> worklist;
+    for (size_t b = 0; b < partition.numberOfBlocks(); b++) {
+        worklist.push_back(b);
+    }
+    std::vector<std::pair<size_t, state_id_t> > splitterIncoming;
+    std::vector<size_t> newBlocks;
+    while (!worklist.empty()) {
+        const size_t splitter = worklist.back();
+        worklist.pop_back();
+
+        splitterIncoming.clear();
+        for (const state_id_t s : partition.statesOf(splitter)) {
+            splitterIncoming.insert(splitterIncoming.end(), incoming.begin() + incomingBegin[s], incoming.begin() + incomingBegin[s + 1]);
+        }
+        std::sort(splitterIncoming.begin(), splitterIncoming.end());
+
+        for (size_t i = 0; i < splitterIncoming.size(); ) {
+            const size_t label = splitterIncoming[i].first;
+            for (; i < splitterIncoming.size() && splitterIncoming[i].first == label; i++) {
+                partition.mark(splitterIncoming[i].second);
+            }
+            partition.split(newBlocks);
+            worklist.insert(worklist.end(), newBlocks.begin(), newBlocks.end());
+        }
+    }
+
+    // number the classes in order of their first state, so that state 0 stays in class 0
+    std::vector<state_id_t> classOfBlock(partition.numberOfBlocks(), NONE_STATE);
+    classes.clear();
+    for (state_id_t s = 0; s < nStates; s++) {
+        const size_t b = partition.blockOf(s);
+        if (classOfBlock[b] == NONE_STATE) {
+            classOfBlock[b] = classes.size();
+            classes.emplace_back();
+        }
+        classes[classOfBlock[b]].push_back(s);
+    }
+
+    quotientMachine.clear();
+    quotientMachine.reserve(classes.size());
+    for (const std::vector<state_id_t>& stateClass : classes) {
+        std::vector<Transition> transitions;
+        for (const Transition& t : machine[stateClass[0]]) {
+            transitions.push_back(Transition(classOfBlock[partition.blockOf(t.nextState)], t.input, t.output));
+        }
+        quotientMachine.push_back(std::move(transitions));
+    }
+}
+
+}
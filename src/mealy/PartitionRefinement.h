@@ -0,0 +1,21 @@
+#pragma once
+
+#include <vector>
+
+#include "memin/Machine.h"
+
+namespace mealy {
+
+/*
+ * Merges states of 'machine' that are equivalent under their specified
+ * behaviour, i.e. that have transitions with the same inputs and outputs
+ * to equivalent successors. Uses Hopcroft's partition refinement and
+ * runs in time O(m log n) for m transitions and n states.
+ * The quotient machine is written to 'quotientMachine', where state 0 is
+ * the class of state 0, and the states of each class to 'classes'.
+ * Merging equivalent states preserves the minimal number of states, so
+ * the quotient machine can be minimized instead of the original one.
+ */
+void computeQuotientMachine(const machine_t& machine, machine_t& quotientMachine, std::vector<std::vector<state_id_t> >& classes);
+
+}
@@ -7,11 +7,13 @@
  *      Author: Philipp Meyer
  */
 
+#include <algorithm>
+
 #include "DIMACSWriter.h"
 
 namespace mealy {
 
-DIMACSWriter::DIMACSWriter(int verbosity) : verbosity(verbosity) { }
+DIMACSWriter::DIMACSWriter(int verbosity) : verbosity(verbosity), interrupted(false), curLiteral(1), maxClasses(0), numFixedClasses(0) { }
 
 void DIMACSWriter::computeReducedInputAlphabet(std::unordered_set<size_t>& reducedInputAlphabet, size_t numInputs, std::vector<std::vector<state_id_t> >& machineNextState, int verbosity) {
     std::unordered_map<size_t, std::vector<std::vector<state_id_t> > > hashmap;
@@ -99,9 +101,23 @@ void DIMACSWriter::addLitToClause(Minisat::vec<Minisat::Lit>& clause, lit_t lit)
     clause.push((lit>0) ? Minisat::mkLit(var) : ~Minisat::mkLit(var));
 }
 
-void DIMACSWriter::buildCNF(std::vector<std::pair<state_id_t, state_id_t> >& literalToStateClass, state_id_t numClasses, std::vector<std::vector<state_id_t> >& machineNextState, std::vector<bool>& incompMatrix, std::vector<state_id_t>& pairwiseIncStates, size_t numInputs) {
+void DIMACSWriter::buildCNF(std::vector<std::pair<state_id_t, state_id_t> >& literalToStateClass, state_id_t numClasses, std::vector<std::vector<state_id_t> >& machineNextState, const IncompMatrix& incompMatrix, std::vector<state_id_t>& pairwiseIncStates, size_t numInputs) {
     state_id_t nStates = machineNextState.size();
     curLiteral = 1;
+    maxClasses = numClasses;
+    numFixedClasses = std::min<state_id_t>(pairwiseIncStates.size(), numClasses);
+
+    //using class i+1 implies using class i
+    activationLiterals.assign(numClasses, -1);
+    for (state_id_t i = numFixedClasses; i < numClasses; i++) {
+        activationLiterals[i] = curLiteral++;
+        if (i > numFixedClasses) {
+            Minisat::vec<Minisat::Lit> clause;
+            addLitToClause(clause, -activationLiterals[i]);
+            addLitToClause(clause, activationLiterals[i-1]);
+            solver.addClause(clause);
+        }
+    }
 
     stateClassToLiteral.resize(nStates*numClasses);
     for (state_id_t i = 0; i < nStates*numClasses; i++) stateClassToLiteral[i] = -1;
@@ -121,7 +137,7 @@ void DIMACSWriter::buildCNF(std::vector<std::pair<state_id_t, state_id_t> >& lit
     for (state_id_t i = 0; i < numClasses; i++) {
         std::vector<state_id_t>& curVector = statesThatCanBeInClass[i];
         for (state_id_t s = 0; s < nStates; s++) {
-            if (i < pairwiseIncStates.size() && incompMatrix[ai(s, pairwiseIncStates[i], nStates)]) continue;
+            if (i < pairwiseIncStates.size() && incompMatrix.get(s, pairwiseIncStates[i])) continue;
             curVector.push_back(s);
         }
     }
@@ -130,7 +146,7 @@ void DIMACSWriter::buildCNF(std::vector<std::pair<state_id_t, state_id_t> >& lit
     for (state_id_t s = 0; s < nStates; s++) {
         Minisat::vec<Minisat::Lit> clause;
         for (state_id_t i = 0; i < numClasses; i++) {
-            if (i < pairwiseIncStates.size() && incompMatrix[ai(s, pairwiseIncStates[i], nStates)]) continue;
+            if (i < pairwiseIncStates.size() && incompMatrix.get(s, pairwiseIncStates[i])) continue;
             addLitToClause(clause, getStateLiteral(s,i,numClasses));
         }
         solver.addClause(clause);
@@ -141,7 +157,7 @@ void DIMACSWriter::buildCNF(std::vector<std::pair<state_id_t, state_id_t> >& lit
         state_id_t s = pairwiseIncStates[i];
 
         for (state_id_t incompS = 0; incompS < nStates; incompS++) {
-            if (!incompMatrix[ai(s, incompS, nStates)]) continue;
+            if (!incompMatrix.get(s, incompS)) continue;
             Minisat::vec<Minisat::Lit> clause;
             addLitToClause(clause, -getStateLiteral(incompS,i,numClasses));
             solver.addClause(clause);
@@ -150,9 +166,9 @@ void DIMACSWriter::buildCNF(std::vector<std::pair<state_id_t, state_id_t> >& lit
 
     for (state_id_t s = 0; s < nStates; s++) {
         for (state_id_t i = 0; i < numClasses; i++) {
-            if (i < pairwiseIncStates.size() && incompMatrix[ai(s, pairwiseIncStates[i], nStates)]) continue;
+            if (i < pairwiseIncStates.size() && incompMatrix.get(s, pairwiseIncStates[i])) continue;
             for (state_id_t incompS = s+1; incompS<nStates; incompS++) {
-                if (!incompMatrix[ai(s, incompS, nStates)]) continue;
+                if (!incompMatrix.get(s, incompS)) continue;
                 Minisat::vec<Minisat::Lit> clause;
                 addLitToClause(clause, -getStateLiteral(s,i,numClasses));
                 addLitToClause(clause, -getStateLiteral(incompS,i,numClasses));
@@ -191,7 +207,7 @@ void DIMACSWriter::buildCNF(std::vector<std::pair<state_id_t, state_id_t> >& lit
                 if (succS == NONE_STATE) continue;
 
                 for (state_id_t j = 0; j < numClasses; j++) {
-                    if (j < pairwiseIncStates.size() && incompMatrix[ai(succS, pairwiseIncStates[j], nStates)]) continue;
+                    if (j < pairwiseIncStates.size() && incompMatrix.get(succS, pairwiseIncStates[j])) continue;
                     possibleSuccClasses[j]=true;
                     if (j < smallestSuccClass) smallestSuccClass=j;
                     if (j > largestSuccClass) largestSuccClass=j;
@@ -207,6 +223,10 @@ void DIMACSWriter::buildCNF(std::vector<std::pair<state_id_t, state_id_t> >& lit
             }
 
             if (clause.size() == 0) continue;
+            //unused classes have no successors
+            if (i >= numFixedClasses) {
+                addLitToClause(clause, -activationLiterals[i]);
+            }
             solver.addClause(clause);
 
             for (auto sIt = statesThatCanBeInClassI.cbegin(); sIt != statesThatCanBeInClassI.cend(); sIt++) {
@@ -237,16 +257,30 @@ void DIMACSWriter::buildCNF(std::vector<std::pair<state_id_t, state_id_t> >& lit
 
     for (state_id_t i = 0; i < nStates; i++) {
         for (state_id_t j = 0; j < numClasses; j++) {
-            if (stateClassToLiteral[ai(i,j,numClasses)] != -1) {
-                literalToStateClass[stateClassToLiteral[ai(i,j,numClasses)]] = {i,j};
+            lit_t lit = stateClassToLiteral[ai(i,j,numClasses)];
+            if (lit != -1) {
+                literalToStateClass[lit] = {i,j};
+
+                //states can only be in used classes
+                if (j >= numFixedClasses) {
+                    Minisat::vec<Minisat::Lit> clause;
+                    addLitToClause(clause, -lit);
+                    addLitToClause(clause, activationLiterals[j]);
+                    solver.addClause(clause);
+                }
             }
         }
     }
 }
 
-int DIMACSWriter::checkSatisfiability() {
-    Minisat::vec<Minisat::Lit> dummy;
-    Minisat::lbool ret = solver.solveLimited(dummy);
+int DIMACSWriter::checkSatisfiability(state_id_t numClasses) {
+    //by the implications between the activation literals, disabling the
+    //first unused class disables all following ones
+    Minisat::vec<Minisat::Lit> assumptions;
+    if (numClasses >= numFixedClasses && numClasses < maxClasses) {
+        addLitToClause(assumptions, -activationLiterals[numClasses]);
+    }
+    Minisat::lbool ret = solver.solveLimited(assumptions);
     if (verbosity>0) std::cout << (ret == Minisat::l_True ? "SATISFIABLE\n" : ret == Minisat::l_False ? "UNSATISFIABLE\n" : "INDETERMINATE\n");
 
     if (ret == Minisat::l_True) {
@@ -256,11 +290,23 @@ int DIMACSWriter::checkSatisfiability() {
         return 0;
     }
     else {
-        std::cerr << "Error: MiniSat returned indeterminate result" << std::endl;
+        if (!interrupted) {
+            std::cerr << "Error: MiniSat returned indeterminate result" << std::endl;
+        }
         return -1;
     }
 }
 
+void DIMACSWriter::interrupt() {
+    interrupted = true;
+    solver.interrupt();
+}
+
+void DIMACSWriter::clearInterrupt() {
+    interrupted = false;
+    solver.clearInterrupt();
+}
+
 std::vector<DIMACSWriter::lit_t> DIMACSWriter::getModel() {
     std::vector<lit_t> dimacsOutput;
     for (lit_t i = 0; i < solver.nVars(); i++) {
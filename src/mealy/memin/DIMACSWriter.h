@@ -19,11 +19,13 @@
 #include <fstream>
 #include <sstream>
 #include <sys/time.h>
+#include <atomic>
 
 #include "minisat/core/Solver.h"
 
 #include "util/SpecSeq.h"
 #include "Machine.h"
+#include "IncompMatrix.h"
 
 namespace mealy {
 
@@ -35,11 +37,17 @@ class DIMACSWriter {
     int verbosity;
 
     Minisat::Solver solver;
+    std::atomic<bool> interrupted;
 
     std::vector<lit_t> auxLiteralsMap;
     std::vector<lit_t> stateClassToLiteral;
     lit_t curLiteral;
 
+    //classes below numFixedClasses are always used, class i above is only used if activationLiterals[i] is true
+    state_id_t maxClasses;
+    state_id_t numFixedClasses;
+    std::vector<lit_t> activationLiterals;
+
     lit_t getStateLiteral(state_id_t state, state_id_t sClass, state_id_t numClasses);
 
     lit_t getAuxLiteral(state_id_t sClass);
@@ -52,14 +60,29 @@ class DIMACSWriter {
 
     DIMACSWriter(int verbosity = 0);
 
-    void buildCNF(std::vector<std::pair<state_id_t, state_id_t> >& literalToStateClass, state_id_t numClasses, std::vector<std::vector<state_id_t> >& machineNextState, std::vector<bool>& incompMatrix, std::vector<state_id_t>& pairwiseIncStates, size_t numInputs);
+    /*
+     * Encode the constraints for at most numClasses classes.
+     * The number of classes that may be used is chosen for each call
+     * of checkSatisfiability, so the solver and its learned clauses
+     * are reused for all class counts up to numClasses.
+     */
+    void buildCNF(std::vector<std::pair<state_id_t, state_id_t> >& literalToStateClass, state_id_t numClasses, std::vector<std::vector<state_id_t> >& machineNextState, const IncompMatrix& incompMatrix, std::vector<state_id_t>& pairwiseIncStates, size_t numInputs);
+
+    state_id_t getMaxClasses() const { return maxClasses; }
 
     /*
-     * Check satisfiability of the constructed constraints.
+     * Check satisfiability of the constructed constraints using only
+     * the first numClasses classes.
      * Return 1 if the constraints are satisfiable,
-     * 0 if the constraints and -1 if an error occurred.
+     * 0 if the constraints and -1 if an error occurred
+     * or the check was interrupted.
      */
-    int checkSatisfiability();
+    int checkSatisfiability(state_id_t numClasses);
+
+    //stop a running or the next check of satisfiability, may be called from another thread
+    void interrupt();
+    void clearInterrupt();
+    bool wasInterrupted() const { return interrupted; }
     std::vector<lit_t> getModel();
 
 };
@@ -0,0 +1,44 @@
+#include "IncompMatrix.h"
+
+namespace mealy {
+
+IncompMatrix::IncompMatrix(state_id_t nStates) :
+    nStates(nStates),
+    nBlocks((nStates + BLOCK_SIZE - 1) / BLOCK_SIZE),
+    rowBegin((size_t)nStates + 1)
+{
+    rowBegin[0] = 0;
+    for (state_id_t s = 0; s < nStates; s++) {
+        rowBegin[s + 1] = rowBegin[s] + nBlocks - s / BLOCK_SIZE;
+    }
+    words.resize(rowBegin[nStates], 0);
+}
+
+std::vector<state_id_t> IncompMatrix::countIncompatible() const {
+    std::vector<state_id_t> count(nStates, 0);
+    state_id_t* const countData = count.data();
+
+    #pragma omp parallel for schedule(dynamic, BLOCK_SIZE) reduction(+:countData[:nStates])
+    for (state_id_t s1 = 0; s1 < nStates; s1++) {
+        const state_id_t firstBlock = s1 / BLOCK_SIZE;
+        for (state_id_t b = firstBlock; b < nBlocks; b++) {
+            word_t word = words[rowBegin[s1] + b - firstBlock];
+            //only the upper triangle including the diagonal is stored
+            if (b == firstBlock) {
+                word &= ~(word_t)0 << (s1 % BLOCK_SIZE);
+            }
+            while (word != 0) {
+                const state_id_t s2 = b * BLOCK_SIZE + __builtin_ctzll(word);
+                word &= word - 1;
+                countData[s1]++;
+                if (s2 != s1) {
+                    countData[s2]++;
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "Machine.h"
+
+namespace mealy {
+
+/*
+ * Symmetric incompatibility relation between the states of a machine,
+ * stored as a bit-packed upper triangle.
+ *
+ * States are grouped into blocks of 64, and row s holds the columns from
+ * the start of the block of s to the end, so that a block of columns of a
+ * row is exactly one word. Filling the matrix tile by tile of 64 x 64
+ * states keeps the transitions of both tiles in cache.
+ */
+class IncompMatrix {
+  public:
+    typedef uint64_t word_t;
+    static constexpr state_id_t BLOCK_SIZE = 64;
+
+  private:
+    state_id_t nStates;
+    state_id_t nBlocks;
+    std::vector<size_t> rowBegin;
+    std::vector<word_t> words;
+
+    //requires row <= col
+    inline size_t wordIndex(state_id_t row, state_id_t col) const {
+        return rowBegin[row] + col / BLOCK_SIZE - row / BLOCK_SIZE;
+    }
+
+  public:
+    IncompMatrix(state_id_t nStates);
+
+    inline state_id_t size() const { return nStates; }
+    inline state_id_t numberOfBlocks() const { return nBlocks; }
+
+    //can be called concurrently with setBlock and testAndSet
+    inline bool get(state_id_t s1, state_id_t s2) const {
+        if (s1 > s2) std::swap(s1, s2);
+        word_t word;
+        #pragma omp atomic read
+        word = words[wordIndex(s1, s2)];
+        return (word >> (s2 % BLOCK_SIZE)) & 1;
+    }
+
+    //word of row s holding the columns of block b, requires that b is not before the block of s,
+    //can be called concurrently with setBlock and testAndSet
+    inline word_t getBlock(state_id_t s, state_id_t b) const {
+        word_t word;
+        #pragma omp atomic read
+        word = words[rowBegin[s] + b - s / BLOCK_SIZE];
+        return word;
+    }
+
+    //sets the bits of mask in the word of row s holding the columns of block b,
+    //returns the bits which were not set before, can be called concurrently
+    inline word_t setBlock(state_id_t s, state_id_t b, word_t mask) {
+        word_t& word = words[rowBegin[s] + b - s / BLOCK_SIZE];
+        word_t old;
+        #pragma omp atomic capture
+        { old = word; word |= mask; }
+        return mask & ~old;
+    }
+
+    //sets the pair to incompatible, returns true if it was not set before, can be called concurrently
+    inline bool testAndSet(state_id_t s1, state_id_t s2) {
+        if (s1 > s2) std::swap(s1, s2);
+        const word_t mask = (word_t)1 << (s2 % BLOCK_SIZE);
+        if (getBlock(s1, s2 / BLOCK_SIZE) & mask) {
+            return false;
+        }
+        return setBlock(s1, s2 / BLOCK_SIZE, mask) != 0;
+    }
+
+    //number of states incompatible to each state
+    std::vector<state_id_t> countIncompatible() const;
+};
+
+}
@@ -8,6 +8,8 @@
  */
 #include "MachineBuilder.h"
 
+#include "util/SpecSeqSet.h"
+
 namespace mealy {
 
 bool buildMachine(std::vector<std::vector<state_id_t> >& newMachineNextState, std::vector<std::vector<std::vector<SpecSeq<letter_t>>> >& newMachineOutput, state_id_t& newResetState, std::vector<std::vector<state_id_t> >& newStates, state_id_t nClasses, std::vector<int>& dimacsOutput, std::vector<std::pair<state_id_t, state_id_t> >& literalToStateClass, std::vector<std::vector<state_id_t> >& origMachineNextState, std::vector<std::vector<std::vector<SpecSeq<letter_t>>> >& origMachineOutput, state_id_t origResetState, size_t numInputs, const int verbosity) {
@@ -69,7 +71,10 @@ bool buildMachine(std::vector<std::vector<state_id_t> >& newMachineNextState, st
                             }
                         }
                     }
-                    output = newOutputs;
+                    //drop duplicate and subsumed outputs, which would multiply in further intersections
+                    SpecSeqSet<letter_t> outputSet(newOutputs);
+                    outputSet.removeSubsumed();
+                    output = outputSet.toVector();
                     if (output.empty()) {
                         // TODO: this could happen when combining (-0, 0- and 10+01)
                         if (verbosity >= 1) {
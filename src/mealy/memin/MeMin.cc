@@ -9,24 +9,84 @@
 #include <vector>
 #include <queue>
 #include <algorithm>
+#include <tuple>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <thread>
+#include <chrono>
 
 #include "minisat/mtl/XAlloc.h"
 
 #include "MeMin.h"
+#include "IncompMatrix.h"
 #include "util/SpecSeq.h"
+#include "util/SpecSeqSet.h"
+#include "util/Statistics.h"
+#include "util/Memory.h"
 #include "DIMACSWriter.h"
 #include "MachineBuilder.h"
 
+#include "omp.h"
+
 namespace mealy {
 
-void computePredecessorMap(const machine_t& states, std::vector<std::unordered_map<SpecSeq<letter_t>,std::vector<state_id_t> > >& pred);
-void computeIncompMatrix(const machine_t& states, std::vector<std::unordered_map<SpecSeq<letter_t>,std::vector<state_id_t> > >& pred, std::vector<bool>& incompMatrix);
-std::vector<std::vector<bool> > getTransitivelyCompatibleStates(const machine_t& states, std::vector<bool>& incompMatrix);
-void splitTransitions(const machine_t& states, int numInputBits, std::vector<bool>& incompMatrix, std::vector<std::vector<state_id_t> >& newNextStates, std::vector<std::vector<std::vector<SpecSeq<letter_t>>> >& newOutput, std::vector<SpecSeq<letter_t>>& inputIDToSpecSeq);
-std::unordered_set<SpecSeq<letter_t>> getDisjointInputSet(const machine_t& states, int numInputBits, std::vector<bool>& eqClass);
-void findPairwiseIncStates(std::vector<state_id_t>& pairwiseIncStates, std::vector<bool>& incompMatrix, state_id_t nStates);
+//smallest number of classes for which the constraints are encoded
+constexpr state_id_t MIN_ENCODED_CLASSES = 16;
+
+//interval for checking the memory limit during the search
+constexpr std::chrono::milliseconds MEMORY_POLL_INTERVAL(100);
+
+//predecessors of each state in CSR format, grouped by the input of the transition
+struct PredecessorMap {
+    //groups of state s are groupBegin[s] to groupBegin[s+1]-1
+    std::vector<size_t> groupBegin;
+    SpecSeqSet<letter_t> groupInput;
+    //predecessors of group g are predStates[predBegin[g]] to predStates[predBegin[g+1]-1]
+    std::vector<size_t> predBegin;
+    std::vector<state_id_t> predStates;
+};
+
+void computePredecessorMap(const machine_t& states, PredecessorMap& pred);
+void computeIncompMatrix(const machine_t& states, const PredecessorMap& pred, IncompMatrix& incompMatrix);
+std::vector<std::vector<state_id_t> > getTransitivelyCompatibleStates(const machine_t& states, const IncompMatrix& incompMatrix);
+void splitTransitions(const machine_t& states, int numInputBits, const IncompMatrix& incompMatrix, std::vector<std::vector<state_id_t> >& newNextStates, std::vector<std::vector<std::vector<SpecSeq<letter_t>>> >& newOutput, std::vector<SpecSeq<letter_t>>& inputIDToSpecSeq);
+SpecSeqSet<letter_t> getDisjointInputSet(const machine_t& states, int numInputBits, const std::vector<state_id_t>& eqClass);
+void findPairwiseIncStates(std::vector<state_id_t>& pairwiseIncStates, const IncompMatrix& incompMatrix, state_id_t nStates);
+
+//constraints on the classes of the minimized machine
+struct ClassConstraints {
+    state_id_t nStates;
+    std::vector<std::vector<state_id_t> >& nextStatesMap;
+    const IncompMatrix& incompMatrix;
+    std::vector<state_id_t>& pairwiseIncStates;
+    size_t numInputs;
+};
+
+//smallest satisfiable number of classes with a model, or nStates if there is none,
+//which is only known to be the minimum if the search was not stopped by the budget
+struct ClassSearchResult {
+    state_id_t nClasses;
+    bool exact;
+    std::vector<DIMACSWriter::lit_t> model;
+    std::vector<std::pair<state_id_t, state_id_t> > literalToStateClass;
+};
+
+bool searchClasses(const ClassConstraints& constraints, const MinimizationOptions& options, const std::chrono::steady_clock::time_point deadline, const size_t memoryLimit, const int verbosity, ClassSearchResult& result);
+
+int minimizeMachineMeMin(const machine_t& machine, state_id_t resetState, int numInputBits, int numOutputBits, machine_t& minimizedMachine, std::vector<std::vector<state_id_t> >& newStates, const MinimizationOptions& options, const int verbosity) {
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    if (options.time_limit.count() > 0) {
+        deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(options.time_limit);
+    }
+    //the memory budget is for the growth of the process during minimization, as the
+    //resident memory also contains the JVM, the BDDs and the machine itself
+    size_t memoryLimit = 0;
+    if (options.max_memory > 0) {
+        memoryLimit = resident_memory() + options.max_memory;
+    }
 
-int minimizeMachineMeMin(const machine_t& machine, state_id_t resetState, int numInputBits, int numOutputBits, machine_t& minimizedMachine, std::vector<std::vector<state_id_t> >& newStates, const int verbosity) {
     try {
         timeval start, end;
         gettimeofday(&start, 0);
@@ -34,7 +94,7 @@ int minimizeMachineMeMin(const machine_t& machine, state_id_t resetState, int nu
         state_id_t nStates = machine.size();
 
         //predecessors for each state and input
-        std::vector<std::unordered_map<SpecSeq<letter_t>,std::vector<state_id_t> >> pred(nStates);
+        PredecessorMap pred;
         computePredecessorMap(machine, pred);
 
         gettimeofday(&end, 0);
@@ -42,8 +102,7 @@ int minimizeMachineMeMin(const machine_t& machine, state_id_t resetState, int nu
         gettimeofday(&start, 0);
 
         //0 if compatible, 1 if incompatible
-        std::vector<bool> incompMatrix;
-        incompMatrix.resize(nStates*nStates, false);
+        IncompMatrix incompMatrix(nStates);
         computeIncompMatrix(machine, pred, incompMatrix);
 
         gettimeofday(&end, 0);
@@ -66,56 +125,44 @@ int minimizeMachineMeMin(const machine_t& machine, state_id_t resetState, int nu
         if (verbosity >= 2) std::cout << "Finding pairwise incomp states: "<< (end.tv_sec*1e6 + end.tv_usec) - (start.tv_sec*1e6 + start.tv_usec) << " usec" << std::endl;
         gettimeofday(&start, 0);
 
-        for (state_id_t nClasses = pairwiseIncStates.size(); nClasses < nStates; nClasses++) {
-            if (verbosity >= 2) std::cout << "Classes: " << nClasses << std::endl;
-
-            //if literal i is true, and literalToStateClass[i]=(s,c) then state s is in class c
-            std::vector<std::pair<state_id_t, state_id_t> > literalToStateClass;
-
-            timeval start2, end2;
-            gettimeofday(&start2, 0);
-
-            DIMACSWriter writer;
-            writer.buildCNF(literalToStateClass, nClasses, nextStatesMap, incompMatrix, pairwiseIncStates, inputIDToSpecSeq.size());
-
-            gettimeofday(&end2, 0);
-            if (verbosity >= 2) std::cout << "Building CNF: "<< (end2.tv_sec*1e6 + end2.tv_usec) - (start2.tv_sec*1e6 + start2.tv_usec) << " usec" << std::endl;
-            gettimeofday(&start2, 0);
+        ClassConstraints constraints{nStates, nextStatesMap, incompMatrix, pairwiseIncStates, inputIDToSpecSeq.size()};
+        ClassSearchResult searchResult;
+        if (!searchClasses(constraints, options, deadline, memoryLimit, verbosity, searchResult)) {
+            return -1;
+        }
+        if (!searchResult.exact && verbosity >= 1) {
+            if (searchResult.nClasses < nStates) {
+                std::cout << "Budget for minimization exhausted, smallest machine found has " << searchResult.nClasses << " states" << std::endl;
+            }
+            else {
+                std::cout << "Budget for minimization exhausted before a smaller machine was found" << std::endl;
+            }
+        }
 
-            int result = writer.checkSatisfiability();
+        gettimeofday(&end, 0);
+        if (verbosity >= 2) std::cout << "Total time for SAT: "<< (end.tv_sec*1e6 + end.tv_usec) - (start.tv_sec*1e6 + start.tv_usec) << " usec" << std::endl;
+        gettimeofday(&start, 0);
 
-            gettimeofday(&end2, 0);
-            if (verbosity >= 2) std::cout << "Minisat: "<< (end2.tv_sec*1e6 + end2.tv_usec) - (start2.tv_sec*1e6 + start2.tv_usec) << " usec" << std::endl;
+        if (searchResult.nClasses < nStates) {
+            state_id_t nClasses = searchResult.nClasses;
+            state_id_t newResetState = NONE_STATE;
 
-            if (result == -1) {
+            std::vector<std::vector<state_id_t> > newMachineNextStatesMap(nClasses);
+            std::vector<std::vector<std::vector<SpecSeq<letter_t>>> > newMachineOutputsMap(nClasses);
+            if (!buildMachine(newMachineNextStatesMap, newMachineOutputsMap, newResetState, newStates, nClasses, searchResult.model, searchResult.literalToStateClass, nextStatesMap, outputsMap, resetState, inputIDToSpecSeq.size(), verbosity)) {
                 return -1;
             }
-            else if (result == 1) {
-                gettimeofday(&end, 0);
-                if (verbosity >= 2) std::cout << "Total time for SAT: "<< (end.tv_sec*1e6 + end.tv_usec) - (start.tv_sec*1e6 + start.tv_usec) << " usec" << std::endl;
-                gettimeofday(&start, 0);
-
-                std::vector<DIMACSWriter::lit_t> dimacsOutput = writer.getModel();
-
-                state_id_t newResetState = NONE_STATE;
 
-                std::vector<std::vector<state_id_t> > newMachineNextStatesMap(nClasses);
-                std::vector<std::vector<std::vector<SpecSeq<letter_t>>> > newMachineOutputsMap(nClasses);
-                if (!buildMachine(newMachineNextStatesMap, newMachineOutputsMap, newResetState, newStates, nClasses, dimacsOutput, literalToStateClass, nextStatesMap, outputsMap, resetState, inputIDToSpecSeq.size(), verbosity)) {
-                    return -1;
-                }
-
-                gettimeofday(&end, 0);
-                if (verbosity >= 2) std::cout << "Building machine: "<< (end.tv_sec*1e6 + end.tv_usec) - (start.tv_sec*1e6 + start.tv_usec) << " usec" << std::endl;
-                gettimeofday(&start, 0);
+            gettimeofday(&end, 0);
+            if (verbosity >= 2) std::cout << "Building machine: "<< (end.tv_sec*1e6 + end.tv_usec) - (start.tv_sec*1e6 + start.tv_usec) << " usec" << std::endl;
+            gettimeofday(&start, 0);
 
-                constructMachine(newMachineNextStatesMap, newMachineOutputsMap, newResetState, newStates, inputIDToSpecSeq, minimizedMachine);
+            constructMachine(newMachineNextStatesMap, newMachineOutputsMap, newResetState, newStates, inputIDToSpecSeq, minimizedMachine);
 
-                gettimeofday(&end, 0);
-                if (verbosity >= 2) std::cout << "Constructing minimized machine: "<< (end.tv_sec*1e6 + end.tv_usec) - (start.tv_sec*1e6 + start.tv_usec) << " usec" << std::endl;
+            gettimeofday(&end, 0);
+            if (verbosity >= 2) std::cout << "Constructing minimized machine: "<< (end.tv_sec*1e6 + end.tv_usec) - (start.tv_sec*1e6 + start.tv_usec) << " usec" << std::endl;
 
-                return 1;
-            }
+            return 1;
         }
     }
     catch (const Minisat::OutOfMemoryException&) {
@@ -125,121 +172,190 @@ int minimizeMachineMeMin(const machine_t& machine, state_id_t resetState, int nu
     return 0;
 }
 
-void computePredecessorMap(const machine_t& states, std::vector<std::unordered_map<SpecSeq<letter_t>,std::vector<state_id_t> > >& pred) {
+void computePredecessorMap(const machine_t& states, PredecessorMap& pred) {
+    //transitions as (successor, input, predecessor), sorted to group them by successor and input
+    std::vector<std::tuple<state_id_t, SpecSeq<letter_t>, state_id_t> > transitions;
     for (state_id_t s = 0; s < states.size(); s++) {
         const std::vector<Transition>& tMap = states[s];
         for (auto it=tMap.cbegin(); it!=tMap.cend(); it++) {
-            pred[it->nextState][it->input].push_back(s);
+            transitions.emplace_back(it->nextState, it->input, s);
         }
     }
+    std::sort(transitions.begin(), transitions.end());
+
+    pred.groupBegin.assign(states.size() + 1, 0);
+    pred.groupInput.clear();
+    pred.predBegin.clear();
+    pred.predStates.clear();
+    pred.predStates.reserve(transitions.size());
+
+    size_t i = 0;
+    for (state_id_t s = 0; s < states.size(); s++) {
+        pred.groupBegin[s] = pred.groupInput.size();
+        while (i < transitions.size() && std::get<0>(transitions[i]) == s) {
+            const SpecSeq<letter_t>& input = std::get<1>(transitions[i]);
+            pred.groupInput.push_back(input);
+            pred.predBegin.push_back(pred.predStates.size());
+            while (i < transitions.size() && std::get<0>(transitions[i]) == s && std::get<1>(transitions[i]) == input) {
+                pred.predStates.push_back(std::get<2>(transitions[i]));
+                i++;
+            }
+        }
+    }
+    pred.groupBegin[states.size()] = pred.groupInput.size();
+    pred.predBegin.push_back(pred.predStates.size());
 }
 
-void propagateIncompStates(state_id_t s1_initial, state_id_t s2_initial, state_id_t nStates, std::vector<std::unordered_map<SpecSeq<letter_t>, std::vector<state_id_t> > >& pred, std::vector<bool>& incompMatrix) {
-    std::queue<std::pair<state_id_t,state_id_t>> worklist;
-    worklist.push({s1_initial, s2_initial});
+//maximal number of pairs waiting for propagation in each thread, further pairs are only propagated in the next round
+constexpr size_t MAX_WORKLIST_SIZE = 1 << 16;
 
+//marks all predecessor pairs of the pairs in the worklist as incompatible, until a fixed point is reached
+//or the worklist overflows, returns false in the latter case
+bool propagateIncompStates(std::vector<std::pair<state_id_t,state_id_t>>& worklist, const PredecessorMap& pred, IncompMatrix& incompMatrix) {
+    bool complete = true;
     while(!worklist.empty()) {
-        const std::pair<state_id_t,state_id_t> pair = std::move(worklist.front());
-        worklist.pop();
+        const std::pair<state_id_t,state_id_t> pair = worklist.back();
+        worklist.pop_back();
         const state_id_t s1 = pair.first;
         const state_id_t s2 = pair.second;
 
-        std::unordered_map<SpecSeq<letter_t>, std::vector<state_id_t> >& pred1 = pred[s1];
-        std::unordered_map<SpecSeq<letter_t>, std::vector<state_id_t> >& pred2 = pred[s2];
-
-        for (auto it1=pred1.cbegin(); it1!=pred1.cend(); it1++) {
-            const SpecSeq<letter_t>& input1 = it1->first;
-            const std::vector<state_id_t>& predStates1 = it1->second;
-
-            for (auto it2=pred2.cbegin(); it2!=pred2.cend(); it2++) {
-                const SpecSeq<letter_t>& input2 = it2->first;
-
-                if (input1.isDisjoint(input2)) continue;
-
-                const std::vector<state_id_t>& predStates2 = it2->second;
-
-                for (state_id_t i1 = 0; i1<predStates1.size(); i1++) {
-                    state_id_t predS1 = predStates1[i1];
-                    for (state_id_t i2 = 0; i2<predStates2.size(); i2++) {
-                        state_id_t predS2 = predStates2[i2];
-                        if (incompMatrix[ai(predS1,predS2,nStates)]) continue;
-
-                        incompMatrix[ai(predS1,predS2,nStates)]=true;
-                        incompMatrix[ai(predS2,predS1,nStates)]=true;
-
-                        worklist.push({predS1, predS2});
+        const size_t g2End = pred.groupBegin[s2+1];
+        for (size_t g1 = pred.groupBegin[s1]; g1 < pred.groupBegin[s1+1]; g1++) {
+            const SpecSeq<letter_t> input1 = pred.groupInput[g1];
+
+            //groups of s2 with inputs overlapping input1
+            for (size_t g2 = pred.groupInput.findOverlapping(input1, pred.groupBegin[s2], g2End); g2 != SpecSeqSet<letter_t>::npos; g2 = pred.groupInput.findOverlapping(input1, g2 + 1, g2End)) {
+                for (size_t i1 = pred.predBegin[g1]; i1 < pred.predBegin[g1+1]; i1++) {
+                    const state_id_t predS1 = pred.predStates[i1];
+                    for (size_t i2 = pred.predBegin[g2]; i2 < pred.predBegin[g2+1]; i2++) {
+                        const state_id_t predS2 = pred.predStates[i2];
+                        if (incompMatrix.testAndSet(predS1, predS2)) {
+                            if (worklist.size() < MAX_WORKLIST_SIZE) {
+                                worklist.push_back({predS1, predS2});
+                            }
+                            else {
+                                complete = false;
+                            }
+                        }
                     }
                 }
             }
         }
     }
+    return complete;
 }
 
-void computeIncompMatrix(const machine_t& states, std::vector<std::unordered_map<SpecSeq<letter_t>, std::vector<state_id_t> > >& pred, std::vector<bool>& incompMatrix) {
-    state_id_t nStates = states.size();
-
-    for (state_id_t s1 = 0; s1 < nStates; s1++) {
-        const std::vector<Transition>& succMap1 = states[s1];
-        for (state_id_t s2 = s1; s2 < nStates; s2++) {
-            if (incompMatrix[ai(s1,s2,nStates)]) continue;
+//checks if two states produce incompatible outputs or move to incompatible states for some common input,
+//where inputs2 holds the inputs of the transitions of the second state
+bool hasIncompatibleTransitions(const std::vector<Transition>& succMap1, const std::vector<Transition>& succMap2, const SpecSeqSet<letter_t>& inputs2, const IncompMatrix& incompMatrix) {
+    for (auto it1=succMap1.cbegin(); it1!=succMap1.cend(); it1++) {
+        const SpecSeq<letter_t>& input1 = it1->input;
 
-            const std::vector<Transition>& succMap2 = states[s2];
+        for (size_t j = inputs2.findOverlapping(input1); j != SpecSeqSet<letter_t>::npos; j = inputs2.findOverlapping(input1, j + 1)) {
+            const auto it2 = succMap2.cbegin() + j;
 
-            for (auto it1=succMap1.cbegin(); it1!=succMap1.cend(); it1++) {
-                const SpecSeq<letter_t>& input1 = it1->input;
+            if (incompMatrix.get(it1->nextState, it2->nextState)) {
+                return true;
+            }
 
-                bool incompOutputFound = false;
-                for (auto it2=succMap2.cbegin(); it2!=succMap2.cend(); it2++) {
-                    const SpecSeq<letter_t>& input2 = it2->input;
+            bool compatible = false;
+            for (const SpecSeq<letter_t>& o1 : it1->output) {
+                for (const SpecSeq<letter_t>& o2 : it2->output) {
+                    if (o1.isCompatible(o2)) {
+                        compatible = true;
+                        break;
+                    }
+                }
+                if (compatible) {
+                    break;
+                }
+            }
+            if (!compatible) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
 
-                    if (input1.isDisjoint(input2)) continue;
+void computeIncompMatrix(const machine_t& states, const PredecessorMap& pred, IncompMatrix& incompMatrix) {
+    const state_id_t nStates = states.size();
+    const state_id_t nBlocks = incompMatrix.numberOfBlocks();
+    const state_id_t blockSize = IncompMatrix::BLOCK_SIZE;
+
+    //tiles of the upper triangle are checked in parallel, and each newly incompatible pair
+    //is propagated to its predecessors by the thread which marked it
+    //if propagation was incomplete due to a full worklist, all pairs are checked again,
+    //which finds the pairs with incompatible successors that were not propagated
+    //inputs of the transitions of each state for batch overlap tests
+    std::vector<SpecSeqSet<letter_t>> stateInputs(nStates);
+    for (state_id_t s = 0; s < nStates; s++) {
+        stateInputs[s].reserve(states[s].size());
+        for (const Transition& t : states[s]) {
+            stateInputs[s].push_back(t.input);
+        }
+    }
 
-                    bool compatible = false;
-                    for (const SpecSeq<letter_t>& o1 : it1->output) {
-                        for (const SpecSeq<letter_t>& o2 : it2->output) {
-                            if (o1.isCompatible(o2)) {
-                                compatible = true;
-                                break;
+    bool complete;
+    do {
+        complete = true;
+
+        #pragma omp parallel
+        {
+            std::vector<std::pair<state_id_t,state_id_t>> worklist;
+            bool localComplete = true;
+
+            #pragma omp for schedule(dynamic) collapse(2)
+            for (state_id_t b1 = 0; b1 < nBlocks; b1++) {
+                for (state_id_t b2 = 0; b2 < nBlocks; b2++) {
+                    if (b2 < b1) continue;
+
+                    const state_id_t s1End = std::min(nStates, (b1 + 1) * blockSize);
+                    const state_id_t s2End = std::min(nStates, (b2 + 1) * blockSize);
+                    for (state_id_t s1 = b1 * blockSize; s1 < s1End; s1++) {
+                        const std::vector<Transition>& succMap1 = states[s1];
+
+                        for (state_id_t s2 = std::max(s1, b2 * blockSize); s2 < s2End; s2++) {
+                            if (incompMatrix.get(s1, s2)) continue;
+                            if (!hasIncompatibleTransitions(succMap1, states[s2], stateInputs[s2], incompMatrix)) continue;
+                            if (!incompMatrix.testAndSet(s1, s2)) continue;
+
+                            worklist.push_back({s1, s2});
+                            if (!propagateIncompStates(worklist, pred, incompMatrix)) {
+                                localComplete = false;
                             }
                         }
-                        if (compatible) {
-                            break;
-                        }
-                    }
-                    if (compatible) {
-                        continue;
                     }
-
-                    incompMatrix[ai(s1,s2,nStates)] = true;
-                    incompMatrix[ai(s2,s1,nStates)] = true;
-
-                    propagateIncompStates(s1, s2, nStates, pred, incompMatrix);
-
-                    incompOutputFound = true;
-                    break;
                 }
-                if (incompOutputFound) break;
+            }
+
+            if (!localComplete) {
+                #pragma omp atomic write
+                complete = false;
             }
         }
-    }
+    } while (!complete);
 }
 
 //partitions the set of states into equivalence classes, s.t. two states are in the same class if they are transitively compatible
-//ret[i][s]==true iff state s is in class i
-std::vector<std::vector<bool> > getTransitivelyCompatibleStates(const machine_t& states, std::vector<bool>& incompMatrix) {
-    std::vector<std::vector<bool> > ret;
+//ret[i] contains the states of class i in ascending order
+std::vector<std::vector<state_id_t> > getTransitivelyCompatibleStates(const machine_t& states, const IncompMatrix& incompMatrix) {
+    std::vector<std::vector<state_id_t> > ret;
 
     state_id_t nStates = states.size();
-    std::vector<bool> processedStates;
-    processedStates.resize(nStates, false);
 
+    //states not yet assigned to a class, in ascending order
+    std::vector<state_id_t> remainingStates(nStates);
     for (state_id_t s = 0; s < nStates; s++) {
-        if (processedStates[s]) continue;
-        processedStates[s] = true;
+        remainingStates[s] = s;
+    }
+
+    while (!remainingStates.empty()) {
+        state_id_t s = remainingStates.front();
+        remainingStates.erase(remainingStates.begin());
 
-        std::vector<bool> curSet;
-        curSet.resize(nStates, 0);
-        curSet[s]=true;
+        std::vector<state_id_t> curSet;
+        curSet.push_back(s);
 
         std::queue<state_id_t> worklist;
         worklist.push(s);
@@ -248,15 +364,21 @@ std::vector<std::vector<bool> > getTransitivelyCompatibleStates(const machine_t&
             state_id_t curS = worklist.front();
             worklist.pop();
 
-            for (state_id_t i = s; i < nStates; i++) {
-                if (processedStates[i]) continue;
-                if (incompMatrix[ai(curS,i,nStates)]) continue;
-
-                worklist.push(i);
-                processedStates[i] = true;
-                curSet[i]=true;
+            //keep incompatible states, and move compatible ones to the class
+            size_t k = 0;
+            for (size_t j = 0; j < remainingStates.size(); j++) {
+                const state_id_t i = remainingStates[j];
+                if (incompMatrix.get(curS, i)) {
+                    remainingStates[k++] = i;
+                }
+                else {
+                    worklist.push(i);
+                    curSet.push_back(i);
+                }
             }
+            remainingStates.resize(k);
         }
+        std::sort(curSet.begin(), curSet.end());
         ret.push_back(curSet);
     }
 
@@ -264,19 +386,19 @@ std::vector<std::vector<bool> > getTransitivelyCompatibleStates(const machine_t&
 }
 
 //compatible states must not have transitions with overlapping inputs
-void splitTransitions(const machine_t& states, int numInputBits, std::vector<bool>& incompMatrix, std::vector<std::vector<state_id_t> >& newNextStates, std::vector<std::vector<std::vector<SpecSeq<letter_t>>> >& newOutput, std::vector<SpecSeq<letter_t>>& inputIDToSpecSeq) {
-    std::vector<std::vector<bool> > tcs = getTransitivelyCompatibleStates(states, incompMatrix);
+void splitTransitions(const machine_t& states, int numInputBits, const IncompMatrix& incompMatrix, std::vector<std::vector<state_id_t> >& newNextStates, std::vector<std::vector<std::vector<SpecSeq<letter_t>>> >& newOutput, std::vector<SpecSeq<letter_t>>& inputIDToSpecSeq) {
+    std::vector<std::vector<state_id_t> > tcs = getTransitivelyCompatibleStates(states, incompMatrix);
 
-    std::vector<std::unordered_set<SpecSeq<letter_t>> > disjInputsForTCS(tcs.size());
+    std::vector<SpecSeqSet<letter_t> > disjInputsForTCS(tcs.size());
 
     std::unordered_map<SpecSeq<letter_t>, size_t> specSeqToInputID;
 
     for (state_id_t i = 0; i < tcs.size(); i++) {
-        std::unordered_set<SpecSeq<letter_t>> disjInputs = getDisjointInputSet(states, numInputBits, tcs[i]);
-        disjInputsForTCS[i] = disjInputs;
+        disjInputsForTCS[i] = getDisjointInputSet(states, numInputBits, tcs[i]);
+        const SpecSeqSet<letter_t>& disjInputs = disjInputsForTCS[i];
 
-        for (auto it=disjInputs.cbegin(); it!=disjInputs.cend(); it++) {
-            const SpecSeq<letter_t> disjInput = *it;
+        for (size_t k = 0; k < disjInputs.size(); k++) {
+            const SpecSeq<letter_t> disjInput = disjInputs[k];
 
             if (specSeqToInputID.count(disjInput)>0) continue;
 
@@ -286,11 +408,9 @@ void splitTransitions(const machine_t& states, int numInputBits, std::vector<boo
     }
 
     for (size_t i = 0; i < tcs.size(); i++) {
-        std::unordered_set<SpecSeq<letter_t>>& disjInputs = disjInputsForTCS[i];
+        const SpecSeqSet<letter_t>& disjInputs = disjInputsForTCS[i];
 
-        std::vector<bool>& tcsi = tcs[i];
-        for (state_id_t curTcs = 0; curTcs < states.size(); curTcs++) {
-            if (!tcsi[curTcs]) continue;
+        for (const state_id_t curTcs : tcs[i]) {
             const std::vector<Transition>& curMap = states[curTcs];
 
             std::vector<state_id_t>& curNextState = newNextStates[curTcs];
@@ -304,19 +424,11 @@ void splitTransitions(const machine_t& states, int numInputBits, std::vector<boo
             for (auto mIt=curMap.cbegin(); mIt!=curMap.cend(); mIt++) {
                 const SpecSeq<letter_t>& input = mIt->input;
 
-                if (disjInputs.count(input)>0) {
-                    size_t inputID = specSeqToInputID[input];
+                //the disjoint inputs contained in the input, including the input itself
+                for (size_t k = disjInputs.findSubset(input); k != SpecSeqSet<letter_t>::npos; k = disjInputs.findSubset(input, k + 1)) {
+                    size_t inputID = specSeqToInputID[disjInputs[k]];
                     curNextState[inputID] = mIt->nextState;
                     curOutput[inputID] = mIt->output;
-                } else {
-                    for (auto sIt=disjInputs.cbegin(); sIt!=disjInputs.cend(); sIt++) {
-                        const SpecSeq<letter_t>& disjInput = *sIt;
-                        if (disjInput.isSubset(input)) {
-                            size_t inputID = specSeqToInputID[disjInput];
-                            curNextState[inputID] = mIt->nextState;
-                            curOutput[inputID] = mIt->output;
-                        }
-                    }
                 }
             }
         }
@@ -324,30 +436,16 @@ void splitTransitions(const machine_t& states, int numInputBits, std::vector<boo
 }
 
 //computes a set of non-overlapping input sequences s.t. all transitions for states in eqClass are covered
-std::unordered_set<SpecSeq<letter_t>> getDisjointInputSet(const machine_t& states, int numInputBits, std::vector<bool>& eqClass) {
-    state_id_t nStates = states.size();
-    std::unordered_set<SpecSeq<letter_t>, std::hash<SpecSeq<letter_t>>> disjointInputs;
+SpecSeqSet<letter_t> getDisjointInputSet(const machine_t& states, int numInputBits, const std::vector<state_id_t>& eqClass) {
+    SpecSeqSet<letter_t> disjointInputs;
 
-    state_id_t curS;
-    for (curS = 0; curS < nStates; curS++) {
-        if (eqClass[curS]) break;
-    }
-    if (curS >= nStates) return std::unordered_set<SpecSeq<letter_t>>();
+    if (eqClass.empty()) return disjointInputs;
 
     bool nonFullySpecInputFound = false;
 
-    const std::vector<Transition>& firstMap = states[curS];
-    for (auto mIp=firstMap.cbegin(); mIp!=firstMap.cend(); mIp++) {
-        SpecSeq<letter_t> input = mIp->input;
-        if (!input.isFullySpecified()) nonFullySpecInputFound=true;
-        disjointInputs.insert(input);
-    }
-
-
     std::unordered_set<SpecSeq<letter_t>, std::hash<SpecSeq<letter_t>>> alreadyInQueue;
     std::queue<SpecSeq<letter_t>> remainingInputs;
-    for (; curS<nStates; curS++) {
-        if (!eqClass[curS]) continue;
+    for (const state_id_t curS : eqClass) {
         const std::vector<Transition>& curMap = states[curS];
         for (auto mIp=curMap.cbegin(); mIp!=curMap.cend(); mIp++) {
             SpecSeq<letter_t> input = mIp->input;
@@ -360,99 +458,78 @@ std::unordered_set<SpecSeq<letter_t>> getDisjointInputSet(const machine_t& state
     }
 
     if (!nonFullySpecInputFound) {
+        //distinct fully specified inputs are disjoint
         while (!remainingInputs.empty()) {
-            SpecSeq<letter_t> curInput = remainingInputs.front();
+            disjointInputs.push_back(remainingInputs.front());
             remainingInputs.pop();
-            disjointInputs.insert(curInput);
         }
-        std::unordered_set<SpecSeq<letter_t>> ret;
-        for (auto it=disjointInputs.cbegin(); it!=disjointInputs.cend(); it++) {
-            ret.insert(*it);
-        }
-        return ret;
+        return disjointInputs;
     }
 
+    //the inputs of a single state may overlap (e.g. for irredundant covers), so
+    //all inputs, including those of the first state, are refined against the set
     while (!remainingInputs.empty()) {
         SpecSeq<letter_t> curInput = remainingInputs.front();
         remainingInputs.pop();
 
-        if (disjointInputs.count(curInput)>0) continue;
-
-        bool intersectingInputFound=false;
-        for (auto dIt=disjointInputs.cbegin(); dIt != disjointInputs.cend(); dIt++) {
-            SpecSeq<letter_t> disjInput = *dIt;
-
-            if (!disjInput.isDisjoint(curInput)) {
-                intersectingInputFound = true;
-
-                if (curInput.isSubset(disjInput)) {
-                    SpecSeq<letter_t> inters = disjInput.intersect(curInput);
-                    std::vector<SpecSeq<letter_t>> diff = disjInput.diff(curInput, numInputBits);
-                    disjointInputs.erase(disjInput);
-                    disjointInputs.insert(SpecSeq<letter_t>(inters));
-                    for (size_t i=0; i < diff.size(); i++) {
-                        disjointInputs.insert(SpecSeq<letter_t>(diff[i]));
-                    }
-                } else if (disjInput.isSubset(curInput)) {
-                    std::vector<SpecSeq<letter_t>> diff = curInput.diff(disjInput, numInputBits);
-
-                    for (size_t i=0; i < diff.size(); i++) {
-                        remainingInputs.push(SpecSeq<letter_t>(diff[i]));
-                    }
-                } else {
-                    SpecSeq<letter_t> inters = disjInput.intersect(curInput);
-                    std::vector<SpecSeq<letter_t>> diff = disjInput.diff(curInput, numInputBits);
+        //the inputs in the set are disjoint, so at most one of them is equal to the current input
+        const size_t d = disjointInputs.findOverlapping(curInput);
+        if (d == SpecSeqSet<letter_t>::npos) {
+            disjointInputs.push_back(curInput);
+            continue;
+        }
+        const SpecSeq<letter_t> disjInput = disjointInputs[d];
+        if (disjInput == curInput) continue;
+
+        if (curInput.isSubset(disjInput)) {
+            SpecSeq<letter_t> inters = disjInput.intersect(curInput);
+            std::vector<SpecSeq<letter_t>> diff = disjInput.diff(curInput, numInputBits);
+            disjointInputs.erase(d);
+            disjointInputs.push_back(inters);
+            for (size_t i=0; i < diff.size(); i++) {
+                disjointInputs.push_back(diff[i]);
+            }
+        } else if (disjInput.isSubset(curInput)) {
+            std::vector<SpecSeq<letter_t>> diff = curInput.diff(disjInput, numInputBits);
 
-                    disjointInputs.insert(SpecSeq<letter_t>(inters));
+            for (size_t i=0; i < diff.size(); i++) {
+                remainingInputs.push(diff[i]);
+            }
+        } else {
+            SpecSeq<letter_t> inters = disjInput.intersect(curInput);
+            std::vector<SpecSeq<letter_t>> diff = disjInput.diff(curInput, numInputBits);
 
-                    for (size_t i=0; i < diff.size(); i++) {
-                        disjointInputs.insert(SpecSeq<letter_t>(diff[i]));
-                    }
+            disjointInputs.erase(d);
+            disjointInputs.push_back(inters);
 
-                    std::vector<SpecSeq<letter_t>> diff2 = curInput.diff(disjInput, numInputBits);
-                    for (size_t i=0; i < diff2.size(); i++) {
-                        remainingInputs.push(SpecSeq<letter_t>(diff2[i]));
-                    }
+            for (size_t i=0; i < diff.size(); i++) {
+                disjointInputs.push_back(diff[i]);
+            }
 
-                    disjointInputs.erase(disjInput);
-                }
-                break;
+            std::vector<SpecSeq<letter_t>> diff2 = curInput.diff(disjInput, numInputBits);
+            for (size_t i=0; i < diff2.size(); i++) {
+                remainingInputs.push(diff2[i]);
             }
         }
-        if (!intersectingInputFound) {
-            disjointInputs.insert(curInput);
-        }
     }
 
-    std::unordered_set<SpecSeq<letter_t>> ret;
-    for (auto it=disjointInputs.cbegin(); it!=disjointInputs.cend(); it++) {
-        ret.insert(*it);
-    }
-    return ret;
+    return disjointInputs;
 }
 
 class incStateComp {
     std::vector<state_id_t> nIncomp;
 public:
-    incStateComp(std::vector<bool>& incompMatrix, state_id_t nStates) :
-        nIncomp(nStates)
-    {
-        for (state_id_t i=0; i<nStates; i++) {
-            state_id_t c=0;
-            for (state_id_t j=0; j<nStates; j++) {
-                if (incompMatrix[ai(i,j,nStates)]) c++;
-            }
-            nIncomp[i] = c;
-        }
-    }
+    incStateComp(const IncompMatrix& incompMatrix) :
+        nIncomp(incompMatrix.countIncompatible())
+    { }
 
     bool operator() (state_id_t i, state_id_t j) {
         return (nIncomp[i]>nIncomp[j]);
     }
 };
 
-void findPairwiseIncStates(std::vector<state_id_t>& pairwiseIncStates, std::vector<bool>& incompMatrix, state_id_t nStates) {
-    incStateComp comp(incompMatrix, nStates);
+void findPairwiseIncStates(std::vector<state_id_t>& pairwiseIncStates, const IncompMatrix& incompMatrix, state_id_t nStates) {
+    incStateComp comp(incompMatrix);
 
     std::vector<state_id_t> states;
     for (state_id_t i=0; i<nStates; i++) {
@@ -466,7 +543,7 @@ void findPairwiseIncStates(std::vector<state_id_t>& pairwiseIncStates, std::vect
         bool compStateFound = false;
         for (state_id_t j=0; j < pairwiseIncStates.size(); j++) {
             state_id_t s2 = pairwiseIncStates[j];
-            if (!incompMatrix[ai(s1,s2,nStates)]) {
+            if (!incompMatrix.get(s1,s2)) {
                 compStateFound = true;
                 break;
             }
@@ -476,4 +553,244 @@ void findPairwiseIncStates(std::vector<state_id_t>& pairwiseIncStates, std::vect
     }
 }
 
+
+//returns the next number of classes in [lower, upper) to check that is not checked by another thread,
+//or NONE_STATE if there is none
+state_id_t chooseClassCount(const MinimizationSearch search, const state_id_t start, const state_id_t lower, const state_id_t upper, const state_id_t nStates, const std::vector<state_id_t>& running) {
+    std::vector<state_id_t> busy;
+    for (const state_id_t n : running) {
+        if (n >= lower && n < upper) {
+            busy.push_back(n);
+        }
+    }
+    std::sort(busy.begin(), busy.end());
+
+    if (search == MinimizationSearch::LINEAR) {
+        state_id_t nClasses = lower;
+        for (const state_id_t n : busy) {
+            if (n == nClasses) nClasses++;
+        }
+        return nClasses < upper ? nClasses : NONE_STATE;
+    }
+
+    //galloping with doubling distance from the initial lower bound until the first satisfiable number of classes
+    if (upper == nStates) {
+        state_id_t nClasses = lower + (lower - start);
+        while (nClasses < upper - 1 && std::binary_search(busy.begin(), busy.end(), nClasses)) {
+            nClasses += nClasses - start + 1;
+        }
+        nClasses = std::min(nClasses, upper - 1);
+        if (!std::binary_search(busy.begin(), busy.end(), nClasses)) {
+            return nClasses;
+        }
+    }
+
+    //bisect the largest range of numbers that are not checked
+    state_id_t bestBegin = lower;
+    state_id_t bestEnd = lower;
+    state_id_t begin = lower;
+    busy.push_back(upper);
+    for (const state_id_t n : busy) {
+        if (n - begin > bestEnd - bestBegin) {
+            bestBegin = begin;
+            bestEnd = n;
+        }
+        begin = n + 1;
+    }
+    if (bestBegin == bestEnd) {
+        return NONE_STATE;
+    }
+    return bestBegin + (bestEnd - bestBegin) / 2;
+}
+
+//encodes the constraints for at least nClasses classes, with twice that number as reserve for later checks
+std::unique_ptr<DIMACSWriter> encodeClasses(const ClassConstraints& constraints, const state_id_t nClasses, std::vector<std::pair<state_id_t, state_id_t> >& literalToStateClass, const int verbosity) {
+    timeval start, end;
+    gettimeofday(&start, 0);
+
+    state_id_t maxClasses = std::min(constraints.nStates - 1, std::max(2 * nClasses, MIN_ENCODED_CLASSES));
+    std::unique_ptr<DIMACSWriter> writer(new DIMACSWriter());
+    literalToStateClass.clear();
+    writer->buildCNF(literalToStateClass, maxClasses, constraints.nextStatesMap, constraints.incompMatrix, constraints.pairwiseIncStates, constraints.numInputs);
+
+    gettimeofday(&end, 0);
+    Statistics::timer("memin.build_cnf").add(std::chrono::microseconds((end.tv_sec - start.tv_sec) * 1000000 + (end.tv_usec - start.tv_usec)));
+    if (verbosity >= 2) std::cout << "Building CNF for " << maxClasses << " classes: "<< (end.tv_sec*1e6 + end.tv_usec) - (start.tv_sec*1e6 + start.tv_usec) << " usec" << std::endl;
+
+    return writer;
+}
+
+bool searchClasses(const ClassConstraints& constraints, const MinimizationOptions& options, const std::chrono::steady_clock::time_point deadline, const size_t memoryLimit, const int verbosity, ClassSearchResult& result) {
+    const state_id_t nStates = constraints.nStates;
+    const state_id_t start = constraints.pairwiseIncStates.size();
+
+    //a solution with nStates classes always exists, and the search is for the smallest number
+    //of classes in [lower, result.nClasses] for which the constraints are satisfiable
+    state_id_t lower = start;
+    result.nClasses = nStates;
+    result.exact = true;
+    if (lower >= nStates) {
+        return true;
+    }
+    if (std::chrono::steady_clock::now() >= deadline) {
+        result.exact = false;
+        return true;
+    }
+
+    //each thread checks a different number of classes with its own solver
+    int numThreads = options.threads > 0 ? options.threads : omp_get_max_threads();
+    numThreads = std::min<state_id_t>(numThreads, nStates - lower);
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<state_id_t> running(numThreads, NONE_STATE);
+    std::vector<DIMACSWriter*> runningWriters(numThreads, nullptr);
+    bool failed = false;
+    bool finished = false;
+    std::exception_ptr exception;
+
+    //stops all checks, must be called while holding the lock
+    const auto stop = [&]() {
+        result.exact = false;
+        for (DIMACSWriter* runningWriter : runningWriters) {
+            if (runningWriter != nullptr) {
+                runningWriter->interrupt();
+            }
+        }
+        changed.notify_all();
+    };
+
+    //stops the search once the deadline or the memory limit is reached
+    std::thread watchdog;
+    if (deadline != std::chrono::steady_clock::time_point::max() || memoryLimit > 0) {
+        watchdog = std::thread([&]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (!finished) {
+                const auto now = std::chrono::steady_clock::now();
+                if (now >= deadline || (memoryLimit > 0 && resident_memory() > memoryLimit)) {
+                    Statistics::counter("memin.budget_exhausted").add();
+                    stop();
+                    break;
+                }
+                changed.wait_until(lock, std::min(deadline, now + MEMORY_POLL_INTERVAL));
+            }
+        });
+    }
+
+    #pragma omp parallel num_threads(numThreads)
+    {
+        const int t = omp_get_thread_num();
+        std::unique_ptr<DIMACSWriter> writer;
+        std::vector<std::pair<state_id_t, state_id_t> > literalToStateClass;
+
+        try {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (!failed && result.exact && lower < result.nClasses) {
+                const state_id_t nClasses = chooseClassCount(options.search, start, lower, result.nClasses, nStates, running);
+                if (nClasses == NONE_STATE) {
+                    changed.wait(lock);
+                    continue;
+                }
+                running[t] = nClasses;
+                lock.unlock();
+
+                if (verbosity >= 2) std::cout << "Classes: " << nClasses << std::endl;
+
+                //the constraints are only re-encoded if more classes are needed
+                if (!writer || nClasses > writer->getMaxClasses()) {
+                    writer.reset();
+                    writer = encodeClasses(constraints, nClasses, literalToStateClass, verbosity);
+                }
+
+                lock.lock();
+                int satResult = -1;
+                const bool needed = result.exact && nClasses >= lower && nClasses < result.nClasses;
+                if (needed) {
+                    //interrupts are only sent while holding the lock, so none can be lost here
+                    runningWriters[t] = writer.get();
+                    writer->clearInterrupt();
+                    lock.unlock();
+
+                    timeval start2, end2;
+                    gettimeofday(&start2, 0);
+
+                    satResult = writer->checkSatisfiability(nClasses);
+
+                    gettimeofday(&end2, 0);
+                    Statistics::timer("memin.sat").add(std::chrono::microseconds((end2.tv_sec - start2.tv_sec) * 1000000 + (end2.tv_usec - start2.tv_usec)));
+                    if (verbosity >= 2) std::cout << "Minisat for " << nClasses << " classes: "<< (end2.tv_sec*1e6 + end2.tv_usec) - (start2.tv_sec*1e6 + start2.tv_usec) << " usec" << std::endl;
+
+                    lock.lock();
+                    runningWriters[t] = nullptr;
+                }
+                running[t] = NONE_STATE;
+
+                if (!needed || (satResult == -1 && writer->wasInterrupted())) {
+                    Statistics::counter("memin.sat_cancelled").add();
+                }
+                else if (satResult == -1) {
+                    failed = true;
+                }
+                else if (satResult == 1) {
+                    if (nClasses < result.nClasses) {
+                        result.nClasses = nClasses;
+                        result.model = writer->getModel();
+                        result.literalToStateClass = literalToStateClass;
+                    }
+                }
+                else {
+                    lower = std::max(lower, nClasses + 1);
+                }
+
+                //cancel checks that can no longer improve the result
+                for (int u = 0; u < numThreads; u++) {
+                    if (runningWriters[u] != nullptr && (failed || running[u] < lower || running[u] >= result.nClasses)) {
+                        runningWriters[u]->interrupt();
+                    }
+                }
+                changed.notify_all();
+            }
+        }
+        catch (const std::bad_alloc&) {
+            //out of memory is handled like an exhausted budget, so that the best result found so far is kept
+            std::lock_guard<std::mutex> guard(mutex);
+            if (!exception) {
+                exception = std::current_exception();
+            }
+            runningWriters[t] = nullptr;
+            stop();
+        }
+        catch (const Minisat::OutOfMemoryException&) {
+            std::lock_guard<std::mutex> guard(mutex);
+            if (!exception) {
+                exception = std::current_exception();
+            }
+            runningWriters[t] = nullptr;
+            stop();
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> guard(mutex);
+            exception = std::current_exception();
+            failed = true;
+            runningWriters[t] = nullptr;
+            stop();
+        }
+    }
+
+    if (watchdog.joinable()) {
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            finished = true;
+        }
+        changed.notify_all();
+        watchdog.join();
+    }
+
+    //errors are only reported if there is no result at all
+    if (exception && (failed || result.nClasses == nStates)) {
+        std::rethrow_exception(exception);
+    }
+    return !failed;
+}
+
 }
@@ -10,12 +10,34 @@
 
 #include <vector>
 #include <queue>
+#include <chrono>
+#include <limits>
 
 #include "Machine.h"
 #include "util/SpecSeq.h"
 
 namespace mealy {
 
+struct MinimizationOptions {
+    MinimizationSearch search;
+    int threads;
+    // largest number of states after partition refinement for exact minimization,
+    // larger machines are only reduced by partition refinement
+    state_id_t max_exact_states;
+    // budget for the exact minimization, where zero means unbounded, and the memory
+    // budget bounds the growth of the resident memory during minimization
+    std::chrono::duration<double> time_limit;
+    size_t max_memory;
+
+    MinimizationOptions() :
+        search(MinimizationSearch::LINEAR),
+        threads(1),
+        max_exact_states(std::numeric_limits<state_id_t>::max()),
+        time_limit(0),
+        max_memory(0)
+    {};
+};
+
 /*
  * Minimizes the Mealy machine given by 'machine'.
  * Assumes that all states are reachable from 'resetState.
@@ -24,7 +46,15 @@ namespace mealy {
  * The reset state of 'minimizedMachine' is always 0.
  * If the machine could not be minimized, 0 is returned.
  * If an error occurred, -1 is returned.
+ * The number of states is searched linearly upwards from a lower bound,
+ * or with galloping steps followed by a binary search.
+ * With several threads, different numbers of states are checked in parallel,
+ * and checks are cancelled once they cannot improve the result anymore.
+ * A number of 0 threads uses the default number of OpenMP threads.
+ * If the time limit or the memory limit for the resident memory is reached,
+ * the machine with the smallest number of states found so far is returned,
+ * which is only found before the minimum by the galloping search.
  */
-int minimizeMachineMeMin(const machine_t& machine, state_id_t resetState, int numInputBits, int numOutputBits, machine_t& minimizedMachine, std::vector<std::vector<state_id_t> >& newStates, const int verbosity = 0);
+int minimizeMachineMeMin(const machine_t& machine, state_id_t resetState, int numInputBits, int numOutputBits, machine_t& minimizedMachine, std::vector<std::vector<state_id_t> >& newStates, const MinimizationOptions& options = MinimizationOptions(), const int verbosity = 0);
 
 }
@@ -0,0 +1,214 @@
+#include "ExplorationQueue.h"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace pg {
+
+// decrease score for nodes discovered later to mix in BFS aspect
+static inline double decay_score(const double score, const node_id_t env_node) {
+    constexpr double factor = 1.0 - pow(0.5, 6);
+    return score * pow(factor, (double)(env_node / 100));
+}
+
+std::unique_ptr<ExplorationQueue> ExplorationQueue::create(
+        const ExplorationStrategy exploration, const Parity parity_type, const color_t n_colors, const size_t beam_width)
+{
+    switch (exploration) {
+        case ExplorationStrategy::BFS:
+            return std::unique_ptr<ExplorationQueue>(new BFSQueue());
+        case ExplorationStrategy::DFS:
+            return std::unique_ptr<ExplorationQueue>(new DFSQueue());
+        case ExplorationStrategy::PQ:
+            return std::unique_ptr<ExplorationQueue>(new PQQueue());
+        case ExplorationStrategy::BEAM:
+            return std::unique_ptr<ExplorationQueue>(new BeamQueue(beam_width));
+        case ExplorationStrategy::COLOR:
+            return std::unique_ptr<ExplorationQueue>(new ColorQueue(parity_type, n_colors));
+    }
+    throw std::invalid_argument("unknown exploration strategy");
+}
+
+/*
+ * Breadth-first search
+ */
+
+double BFSQueue::score(const ColorScore& cs, const node_id_t ref_id, const node_id_t env_node) const {
+    return -(double)ref_id;
+}
+
+void BFSQueue::push(const node_id_t ref_id, const double score) {
+    queue.update(ref_id, score);
+}
+
+bool BFSQueue::pop(ScoredProductState& state) {
+    state = ScoredProductState(queue.top().priority, queue.top().id);
+    queue.pop();
+    return true;
+}
+
+void BFSQueue::rescore(const node_id_t ref_id, const double score) {
+    // order only depends on the reference id
+}
+
+void BFSQueue::filter(const filter_function& f) {
+    queue.filter(f);
+}
+
+/*
+ * Depth-first search
+ */
+
+double DFSQueue::score(const ColorScore& cs, const node_id_t ref_id, const node_id_t env_node) const {
+    return (double)ref_id;
+}
+
+void DFSQueue::push(const node_id_t ref_id, const double score) {
+    stack.push_back(ref_id);
+}
+
+bool DFSQueue::pop(ScoredProductState& state) {
+    const node_id_t ref_id = stack.back();
+    stack.pop_back();
+    state = ScoredProductState((double)ref_id, ref_id);
+    return true;
+}
+
+void DFSQueue::rescore(const node_id_t ref_id, const double score) {
+    // order only depends on the time of discovery
+}
+
+void DFSQueue::filter(const filter_function& f) {
+    size_t j = 0;
+    for (size_t i = 0; i < stack.size(); i++) {
+        double score = (double)stack[i];
+        if (f(stack[i], score)) {
+            stack[j++] = stack[i];
+        }
+    }
+    stack.resize(j);
+}
+
+/*
+ * Alternating search on maximal and minimal quality scores
+ */
+
+double PQQueue::score(const ColorScore& cs, const node_id_t ref_id, const node_id_t env_node) const {
+    return decay_score(cs.score, env_node);
+}
+
+void PQQueue::push(const node_id_t ref_id, const double score) {
+    queue_max.update(ref_id,  score);
+    queue_min.update(ref_id, -score);
+}
+
+bool PQQueue::pop(ScoredProductState& state) {
+    if (use_max_queue && !queue_max.empty()) {
+        state = ScoredProductState(queue_max.top().priority, queue_max.top().id);
+        queue_max.pop();
+        queue_min.erase(state.ref_id);
+        use_max_queue = false;
+        return true;
+    }
+    else if (!queue_min.empty()) {
+        state = ScoredProductState(queue_min.top().priority, queue_min.top().id);
+        queue_min.pop();
+        queue_max.erase(state.ref_id);
+        use_max_queue = true;
+        return true;
+    }
+    else {
+        use_max_queue = !use_max_queue;
+        return false;
+    }
+}
+
+void PQQueue::rescore(const node_id_t ref_id, const double score) {
+    // only move states towards the front of the respective queue
+    if (queue_max.contains(ref_id)) {
+        queue_max.increase(ref_id,  score);
+    }
+    if (queue_min.contains(ref_id)) {
+        queue_min.increase(ref_id, -score);
+    }
+}
+
+void PQQueue::filter(const filter_function& f) {
+    queue_max.filter(f);
+    queue_min.filter(f);
+}
+
+/*
+ * Beam search with deferred candidates
+ */
+
+double BeamQueue::score(const ColorScore& cs, const node_id_t ref_id, const node_id_t env_node) const {
+    return decay_score(cs.score, env_node);
+}
+
+void BeamQueue::push(const node_id_t ref_id, const double score) {
+    if (!beam.contains(ref_id)) {
+        candidates.update(ref_id, score);
+    }
+}
+
+bool BeamQueue::pop(ScoredProductState& state) {
+    if (beam.empty()) {
+        // start next layer with the best candidates, all others are deferred
+        while (!candidates.empty() && beam.size() < beam_width) {
+            beam.update(candidates.top().id, candidates.top().priority);
+            candidates.pop();
+        }
+    }
+    state = ScoredProductState(beam.top().priority, beam.top().id);
+    beam.pop();
+    return true;
+}
+
+void BeamQueue::rescore(const node_id_t ref_id, const double score) {
+    if (beam.contains(ref_id)) {
+        beam.increase(ref_id, score);
+    }
+    else if (candidates.contains(ref_id)) {
+        candidates.increase(ref_id, score);
+    }
+}
+
+void BeamQueue::filter(const filter_function& f) {
+    beam.filter(f);
+    candidates.filter(f);
+}
+
+/*
+ * Best-first search by color
+ */
+
+double ColorQueue::score(const ColorScore& cs, const node_id_t ref_id, const node_id_t env_node) const {
+    // small colors are more significant, and colors with the parity of the game are good for the system
+    const double significance = 1.0 - (double)cs.color / (double)(n_colors + 1);
+    const bool good_color = ((cs.color + parity_type) % 2) == 0;
+    const double color_score = good_color ? significance : -significance;
+    return decay_score(color_score + cs.score, env_node);
+}
+
+void ColorQueue::push(const node_id_t ref_id, const double score) {
+    queue.update(ref_id, score);
+}
+
+bool ColorQueue::pop(ScoredProductState& state) {
+    state = ScoredProductState(queue.top().priority, queue.top().id);
+    queue.pop();
+    return true;
+}
+
+void ColorQueue::rescore(const node_id_t ref_id, const double score) {
+    if (queue.contains(ref_id)) {
+        queue.increase(ref_id, score);
+    }
+}
+
+void ColorQueue::filter(const filter_function& f) {
+    queue.filter(f);
+}
+
+}
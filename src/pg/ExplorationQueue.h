@@ -0,0 +1,152 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <functional>
+#include <algorithm>
+
+#include "Definitions.h"
+#include "util/IndexedHeap.h"
+
+namespace pg {
+
+struct ScoredProductState {
+    double score;
+    node_id_t ref_id;
+
+    ScoredProductState() :
+        score(0.0),
+        ref_id(NODE_NONE)
+    {}
+    ScoredProductState(double score, node_id_t ref_id) :
+        score(score),
+        ref_id(ref_id)
+    {}
+};
+
+/*
+ * Policy deciding in which order the product states discovered
+ * during the construction of the arena are explored.
+ */
+class ExplorationQueue {
+public:
+    // function called for every queued state when filtering,
+    // may change the score and returns false if the state should be removed
+    typedef std::function<bool(const node_id_t ref_id, double& score)> filter_function;
+
+    virtual ~ExplorationQueue() {}
+
+    virtual bool empty() const = 0;
+    virtual size_t size() const = 0;
+
+    // score for a successor with reference id ref_id reached with the given edge from env_node
+    virtual double score(const ColorScore& cs, const node_id_t ref_id, const node_id_t env_node) const = 0;
+
+    // add a new state or a state that has to be explored again
+    virtual void push(const node_id_t ref_id, const double score) = 0;
+    // take the next state to explore, returns false if no state should be explored in this step
+    virtual bool pop(ScoredProductState& state) = 0;
+    // notify about a new score for a state already in the queue
+    virtual void rescore(const node_id_t ref_id, const double score) = 0;
+    // remove or rescore the states in the queue
+    virtual void filter(const filter_function& f) = 0;
+
+    static std::unique_ptr<ExplorationQueue> create(
+            const ExplorationStrategy exploration, const Parity parity_type, const color_t n_colors, const size_t beam_width);
+};
+
+// explore states in the order they are discovered
+class BFSQueue : public ExplorationQueue {
+private:
+    IndexedHeap<double, node_id_t> queue;
+
+public:
+    bool empty() const override { return queue.empty(); }
+    size_t size() const override { return queue.size(); }
+
+    double score(const ColorScore& cs, const node_id_t ref_id, const node_id_t env_node) const override;
+    void push(const node_id_t ref_id, const double score) override;
+    bool pop(ScoredProductState& state) override;
+    void rescore(const node_id_t ref_id, const double score) override;
+    void filter(const filter_function& f) override;
+};
+
+// explore most recently discovered states first, keeping the frontier small
+class DFSQueue : public ExplorationQueue {
+private:
+    std::vector<node_id_t> stack;
+
+public:
+    bool empty() const override { return stack.empty(); }
+    size_t size() const override { return stack.size(); }
+
+    double score(const ColorScore& cs, const node_id_t ref_id, const node_id_t env_node) const override;
+    void push(const node_id_t ref_id, const double score) override;
+    bool pop(ScoredProductState& state) override;
+    void rescore(const node_id_t ref_id, const double score) override;
+    void filter(const filter_function& f) override;
+};
+
+// alternate between the states with maximal and minimal quality score
+class PQQueue : public ExplorationQueue {
+protected:
+    IndexedHeap<double, node_id_t> queue_max;
+    IndexedHeap<double, node_id_t> queue_min;
+    bool use_max_queue;
+
+public:
+    PQQueue() : use_max_queue(true) {}
+
+    bool empty() const override { return queue_max.empty() && queue_min.empty(); }
+    size_t size() const override { return std::max(queue_max.size(), queue_min.size()); }
+
+    double score(const ColorScore& cs, const node_id_t ref_id, const node_id_t env_node) const override;
+    void push(const node_id_t ref_id, const double score) override;
+    bool pop(ScoredProductState& state) override;
+    void rescore(const node_id_t ref_id, const double score) override;
+    void filter(const filter_function& f) override;
+};
+
+// explore states by quality score, but only the best beam_width states of each layer at once
+class BeamQueue : public ExplorationQueue {
+private:
+    const size_t beam_width;
+    IndexedHeap<double, node_id_t> beam;
+    IndexedHeap<double, node_id_t> candidates;
+
+public:
+    BeamQueue(const size_t beam_width) : beam_width(std::max<size_t>(beam_width, 1)) {}
+
+    bool empty() const override { return beam.empty() && candidates.empty(); }
+    size_t size() const override { return beam.size() + candidates.size(); }
+
+    double score(const ColorScore& cs, const node_id_t ref_id, const node_id_t env_node) const override;
+    void push(const node_id_t ref_id, const double score) override;
+    bool pop(ScoredProductState& state) override;
+    void rescore(const node_id_t ref_id, const double score) override;
+    void filter(const filter_function& f) override;
+};
+
+// best-first search preferring states reached by edges with colors good for the system
+class ColorQueue : public ExplorationQueue {
+private:
+    const Parity parity_type;
+    const color_t n_colors;
+    IndexedHeap<double, node_id_t> queue;
+
+public:
+    ColorQueue(const Parity parity_type, const color_t n_colors) :
+        parity_type(parity_type), n_colors(n_colors)
+    {}
+
+    bool empty() const override { return queue.empty(); }
+    size_t size() const override { return queue.size(); }
+
+    double score(const ColorScore& cs, const node_id_t ref_id, const node_id_t env_node) const override;
+    void push(const node_id_t ref_id, const double score) override;
+    bool pop(ScoredProductState& state) override;
+    void rescore(const node_id_t ref_id, const double score) override;
+    void filter(const filter_function& f) override;
+};
+
+}
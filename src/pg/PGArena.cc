@@ -12,10 +12,14 @@
 #include <map>
 #include <queue>
 #include <memory>
+#include <stdexcept>
 
 #include <boost/functional/hash.hpp>
 
 #include "util/Timer.h"
+#include "util/Memory.h"
+#include "util/Statistics.h"
+#include "util/Profiler.h"
 
 size_t hash_value(const Edge& edge) {
     return std::hash<Edge>()(edge);
@@ -28,11 +32,15 @@ size_t hash_value(const BDD& bdd) {
 namespace pg {
 
 constexpr size_t RESERVE = 4096;
+constexpr size_t MEMORY_CHECK_INTERVAL = 1024;
 
-PGArena::PGArena(const size_t n_inputs, const size_t n_outputs, aut::AutomatonTreeStructure& structure, const ExplorationStrategy exploration, const bool clear_queue) :
-    structure(structure),
+PGArena::PGArena(const size_t n_inputs, const size_t n_outputs, aut::AutomatonTreeStructure& structure, const ExplorationStrategy exploration, const bool clear_queue, const size_t beam_width, const size_t memory_limit) :
+    structure(&structure),
     exploration(exploration),
     clear_queue(clear_queue),
+    beam_width(beam_width),
+    memory_limit(memory_limit),
+    has_labels(true),
     winning_queue(0),
     unreachable_queue(0),
     n_inputs(n_inputs),
@@ -47,6 +55,11 @@ PGArena::PGArena(const size_t n_inputs, const size_t n_outputs, aut::AutomatonTr
     n_sys_edges(0),
     n_env_edges(0)
 {
+    // the automata read joint letters of inputs followed by outputs
+    if (n_inputs + n_outputs > LETTER_BITS) {
+        throw std::invalid_argument("Specification has " + std::to_string(n_inputs + n_outputs) + " signals, but at most " + std::to_string(LETTER_BITS) + " are supported; rebuild with a larger MAX_SIGNALS");
+    }
+
     // reserve some space in the vector to avoid initial resizing, which needs locking for the parallel construction
     sys_succs_begin.reserve(RESERVE);
     sys_succs.reserve(RESERVE);
@@ -84,7 +97,7 @@ PGArena::PGArena(const size_t n_inputs, const size_t n_outputs, aut::AutomatonTr
 
     std::vector<owl::VariableStatus> statuses = structure.getVariableStatuses();
 
-    for (letter_t a = 0; a < n_inputs; a++) {
+    for (size_t a = 0; a < n_inputs; a++) {
         const letter_t bit = ((letter_t)1 << a);
         int status = a >= statuses.size() ? owl::UNUSED : statuses[a];
         if (status == owl::USED) {
@@ -107,9 +120,9 @@ PGArena::PGArena(const size_t n_inputs, const size_t n_outputs, aut::AutomatonTr
             }
         }
     }
-    for (letter_t a = 0; a < n_outputs; a++) {
+    for (size_t a = 0; a < n_outputs; a++) {
         const letter_t bit = ((letter_t)1 << a);
-        const letter_t b = a + n_inputs;
+        const size_t b = a + n_inputs;
         int status = b >= statuses.size() ? owl::UNUSED : statuses[b];
         if (status == owl::USED) {
             relevant_outputs.push_back(a);
@@ -132,8 +145,56 @@ PGArena::PGArena(const size_t n_inputs, const size_t n_outputs, aut::AutomatonTr
         }
     }
 
-    n_env_actions = ((letter_t)1 << relevant_inputs.size());
-    n_sys_actions = ((letter_t)1 << relevant_outputs.size());
+    // actions are enumerated as 64-bit numbers, independent of the width of the letters
+    constexpr size_t MAX_RELEVANT_SIGNALS = std::numeric_limits<uint64_t>::digits;
+    if (relevant_inputs.size() >= MAX_RELEVANT_SIGNALS || relevant_outputs.size() >= MAX_RELEVANT_SIGNALS) {
+        throw std::invalid_argument("Specification has " + std::to_string(relevant_inputs.size()) + " relevant inputs and " +
+                std::to_string(relevant_outputs.size()) + " relevant outputs, but at most " +
+                std::to_string(MAX_RELEVANT_SIGNALS - 1) + " of each are supported");
+    }
+    n_env_actions = ((uint64_t)1 << relevant_inputs.size());
+    n_sys_actions = ((uint64_t)1 << relevant_outputs.size());
+}
+
+PGArena::PGArena(const size_t n_inputs, const size_t n_outputs, const Parity parity_type, const color_t n_colors) :
+    structure(nullptr),
+    exploration(ExplorationStrategy::BFS),
+    clear_queue(false),
+    beam_width(0),
+    memory_limit(0),
+    unused_inputs_mask(0),
+    unused_outputs_mask(0),
+    true_inputs_mask(0),
+    true_outputs_mask(0),
+    false_inputs_mask(0),
+    false_outputs_mask(0),
+    irrelevant_inputs_mask(0),
+    irrelevant_outputs_mask(0),
+    has_labels(false),
+    product_state_size(0),
+    winning_queue(0),
+    unreachable_queue(0),
+    n_inputs(n_inputs),
+    n_outputs(n_outputs),
+    complete(false),
+    solved(false),
+    signal_clear_queue(false),
+    parity_type(parity_type),
+    n_colors(n_colors),
+    initial_node(0),
+    initial_node_ref(0),
+    n_env_actions(0),
+    n_sys_actions(0),
+    n_env_nodes(0),
+    n_sys_nodes(0),
+    n_sys_edges(0),
+    n_env_edges(0)
+{
+    // initialize manager for BDDs
+    manager_input_bdds = Cudd(n_inputs);
+    manager_output_bdds = Cudd(n_outputs);
+    manager_input_bdds.AutodynDisable();
+    manager_output_bdds.AutodynDisable();
 }
 
 PGArena::~PGArena() {
@@ -142,13 +203,6 @@ PGArena::~PGArena() {
     std::vector<BDD>().swap(sys_output);
 }
 
-template <typename Container>
-struct container_hash {
-    std::size_t operator()(Container const& c) const {
-        return boost::hash_range(c.cbegin(), c.cend());
-    }
-};
-
 int PGArena::computeStateLabels(std::vector<node_id_t>& visited_map, std::vector<int>& accumulated_bits) {
     // get visited states
     std::vector<std::set<node_id_t>> visited_states(product_state_size);
@@ -211,70 +265,95 @@ int PGArena::computeStateLabels(std::vector<node_id_t>& visited_map, std::vector
     return state_label_bits;
 }
 
-void PGArena::filter_queue(state_queue& queue, const std::vector<product_state_t>& states, std::unordered_set<node_id_t>& already_queried, const bool new_declared_nodes, std::chrono::duration<double>& time_query, size_t& queried_nodes, size_t& unreachable_nodes_found, size_t& losing_nodes_found, size_t& winning_nodes_found, const bool only_realizability) {
-    std::chrono::high_resolution_clock::time_point start_time;
-    std::chrono::high_resolution_clock::time_point stop_time;
-    state_queue new_queue;
-    for (ScoredProductState& s : queue.container()) {
-        bool keep = true;
-        if (env_node_map[s.ref_id] != NODE_NONE) {
+void PGArena::filter_queue(ExplorationQueue& queue, const StateStore& states, std::unordered_set<node_id_t>& already_queried, const bool new_declared_nodes, std::chrono::duration<double>& time_query, size_t& queried_nodes, size_t& unreachable_nodes_found, size_t& losing_nodes_found, size_t& winning_nodes_found, const bool only_realizability) {
+    // first remove explored and unreachable nodes and collect the nodes to query
+    std::vector<node_id_t> query_ids;
+    queue.filter([&](const node_id_t ref_id, double&) {
+        if (env_node_map[ref_id] != NODE_NONE) {
             // node already explored
-            keep = false;
+            return false;
         }
-        else if (!env_node_reachable[s.ref_id]) {
+        else if (!env_node_reachable[ref_id]) {
             // node unreachable
             unreachable_nodes_found++;
-            keep = false;
+            return false;
         }
-        else if (new_declared_nodes) {
-            auto result = already_queried.insert(s.ref_id);
-            if (result.second) {
-                //Player winner = Player::UNKNOWN;
-                start_time = std::chrono::high_resolution_clock::now();
-                queried_nodes++;
-                Player winner = structure.queryWinner(states[s.ref_id]);
-                stop_time = std::chrono::high_resolution_clock::now();
-                time_query += (stop_time - start_time);
-
-                if (winner == Player::ENV_PLAYER) {
-                    // node unrealizable
-                    losing_nodes_found++;
-                    keep = false;
-                    if (only_realizability) {
-                        env_node_map[s.ref_id] = NODE_BOTTOM;
-                    }
-                    else {
-                        // decrease score otherwise
-                        s.score = 0.1*s.score;
-                        new_queue.push(std::move(s));
+        else if (new_declared_nodes && already_queried.insert(ref_id).second) {
+            query_ids.push_back(ref_id);
+        }
+        return true;
+    });
 
-                    }
+    if (query_ids.empty()) {
+        return;
+    }
+
+    // query all nodes together, so that equal automaton states are only queried once
+    std::vector<product_state_t> query_states;
+    std::vector<const product_state_t*> query_state_ptrs;
+    query_states.reserve(query_ids.size());
+    query_state_ptrs.reserve(query_ids.size());
+    for (const node_id_t ref_id : query_ids) {
+        query_states.push_back(states.get(ref_id));
+        query_state_ptrs.push_back(&query_states.back());
+    }
+    std::vector<Player> winners;
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    structure->queryWinner(query_state_ptrs, winners);
+    const auto stop_time = std::chrono::high_resolution_clock::now();
+    time_query += (stop_time - start_time);
+    queried_nodes += query_ids.size();
+
+    std::unordered_map<node_id_t, Player> known_winners;
+    for (size_t i = 0; i < query_ids.size(); i++) {
+        if (winners[i] == Player::ENV_PLAYER) {
+            losing_nodes_found++;
+            known_winners.insert({ query_ids[i], winners[i] });
+        }
+        else if (winners[i] == Player::SYS_PLAYER) {
+            winning_nodes_found++;
+            known_winners.insert({ query_ids[i], winners[i] });
+        }
+    }
+    if (known_winners.empty()) {
+        return;
+    }
+
+    // remove or rescore entries in place, the heap is restored afterwards in linear time
+    queue.filter([&](const node_id_t ref_id, double& score) {
+        auto it = known_winners.find(ref_id);
+        if (it == known_winners.end()) {
+            return true;
+        }
+        else if (it->second == Player::ENV_PLAYER) {
+            // node unrealizable
+            if (only_realizability) {
+                env_node_map[ref_id] = NODE_BOTTOM;
+                return false;
+            }
+            else {
+                // decrease score otherwise
+                score = 0.1*score;
+            }
+        }
+        else {
+            // node realizable
+            if (only_realizability) {
+                env_node_map[ref_id] = NODE_TOP;
+                return false;
+            }
+            else {
+                // increase score otherwise
+                if (score >= 0.0) {
+                    score = 0.9 + 0.1*score;
                 }
-                else if (winner == Player::SYS_PLAYER) {
-                    // node realizable
-                    winning_nodes_found++;
-                    keep = false;
-                    if (only_realizability) {
-                        env_node_map[s.ref_id] = NODE_TOP;
-                    }
-                    else {
-                        // increase score otherwise
-                        if (s.score >= 0.0) {
-                            s.score = 0.9 + 0.1*s.score;
-                        }
-                        else {
-                            s.score = -0.9 + 0.1*s.score;
-                        }
-                        new_queue.push(std::move(s));
-                    }
+                else {
+                    score = -0.9 + 0.1*score;
                 }
             }
         }
-        if (keep) {
-            new_queue.push(std::move(s));
-        }
-    }
-    std::swap(new_queue, queue);
+        return true;
+    });
 }
 
 void PGArena::reachability_analysis() {
@@ -320,22 +399,38 @@ void PGArena::reachability_analysis() {
     }
 }
 
-void PGArena::constructArena(const bool parallel, const bool only_realizability, const int verbosity) {
-    const product_state_t initial_state = structure.getInitialState();
+void PGArena::constructArena(const bool parallel, const bool only_realizability, const bool product_labels, const int verbosity) {
+    PROFILE_ZONE("constructArena");
+    assert(structure != nullptr);
+    const product_state_t initial_state = structure->getInitialState();
     product_state_size = initial_state.size();
     bool has_lock = false;
 
     if (verbosity >= 1) {
         std::cout << "Product state tree:" << std::endl;
-        structure.print(verbosity);
+        structure->print(verbosity);
     }
 
-    state_queue queue_max;
-    state_queue queue_min;
-    // map from product states in queue to scores and reference ids
-    std::unordered_map< product_state_t, MinMaxState, container_hash<product_state_t> > state_map;
-    std::vector<product_state_t> states;
-    states.reserve(RESERVE);
+    std::unique_ptr<ExplorationQueue> queue = ExplorationQueue::create(exploration, parity_type, n_colors, beam_width);
+    // product states by reference id, spilled to disk in bounded-memory mode
+    StateStore states(product_state_size, memory_limit > 0);
+    // minimal and maximal scores by reference id
+    std::vector<double> min_scores;
+    std::vector<double> max_scores;
+    // set of reference ids for looking up product states
+    auto state_hash = [&states](const node_id_t ref_id) {
+        return states.hash(ref_id);
+    };
+    auto state_equal = [&states](const node_id_t ref_id_1, const node_id_t ref_id_2) {
+        return states.equal(ref_id_1, ref_id_2);
+    };
+    auto state_map = std::unordered_set<node_id_t, decltype(state_hash), decltype(state_equal)>(RESERVE, state_hash, state_equal);
+
+    // edge labels are not needed afterwards when only checking realizability
+    const bool drop_labels = only_realizability && memory_limit > 0;
+    has_labels = !drop_labels;
+    size_t explored_since_check = 0;
+    node_id_t cold_ref_ids = 0;
 
     // cache for system nodes
     auto sys_node_hash = [this](const node_id_t sys_node) {
@@ -377,7 +472,9 @@ void PGArena::constructArena(const bool parallel, const bool only_realizability,
     const node_id_t top_node_ref = env_node_map.size();
     env_node_map.push_back(NODE_TOP);
     env_node_reachable.push_back(true);
-    states.push_back({});
+    states.push_back(product_state_t(product_state_size, NODE_TOP));
+    min_scores.push_back(0.0);
+    max_scores.push_back(0.0);
 
     // add ref for initial node
     initial_node_ref = env_node_map.size();
@@ -385,13 +482,16 @@ void PGArena::constructArena(const bool parallel, const bool only_realizability,
     env_node_reachable.push_back(true);
 
     ScoredProductState initial(1.0, initial_node_ref);
-    state_map.insert({ initial_state, MinMaxState(initial) });
-    queue_max.push(initial);
-    states.push_back(std::move(initial_state));
-
-    bool use_max_queue = true;
+    states.push_back(initial_state);
+    state_map.insert(initial.ref_id);
+    min_scores.push_back(initial.score);
+    max_scores.push_back(initial.score);
+    queue->push(initial.ref_id, initial.score);
 
     std::unordered_set<node_id_t> already_queried;
+    std::vector<std::pair<node_id_t, Player>> declared_refs;
+    std::vector<product_state_t> declared_states;
+    std::vector<std::pair<const product_state_t*, Player>> declarations;
     bool new_winning_nodes = false;
     bool new_declared_nodes = false;
 
@@ -404,11 +504,15 @@ void PGArena::constructArena(const bool parallel, const bool only_realizability,
     size_t losing_nodes_found = 0;
     size_t unreachable_nodes_found = 0;
     size_t queried_nodes = 0;
+    size_t declared_nodes = 0;
+    Statistics::Histogram& queue_sizes = Statistics::histogram("arena.queue_size");
 
-    while (!solved && !(queue_max.empty() && queue_min.empty())) {
+    while (!solved && !queue->empty()) {
 
         // check queue of winning nodes
         if (clear_queue) {
+            // collect all newly won nodes and declare them together
+            declared_refs.clear();
             int32_t winning;
             while (winning_queue.pop(winning)) {
                 new_winning_nodes = true;
@@ -421,18 +525,28 @@ void PGArena::constructArena(const bool parallel, const bool only_realizability,
                     break;
                 }
                 else {
-                    product_state_t& state = states[ref_id];
-                    start_time = std::chrono::high_resolution_clock::now();
-                    if (structure.declareWinning(state, winner)) {
-                        new_declared_nodes = true;
-                    }
-                    stop_time = std::chrono::high_resolution_clock::now();
-                    time_declare += (stop_time - start_time);
+                    declared_refs.push_back({ ref_id, winner });
                 }
             }
             if (solved) {
                 break;
             }
+            if (!declared_refs.empty()) {
+                declared_states.clear();
+                declarations.clear();
+                declared_states.reserve(declared_refs.size());
+                for (const auto& declared : declared_refs) {
+                    declared_states.push_back(states.get(declared.first));
+                    declarations.push_back({ &declared_states.back(), declared.second });
+                }
+                start_time = std::chrono::high_resolution_clock::now();
+                if (structure->declareWinning(declarations) > 0) {
+                    new_declared_nodes = true;
+                }
+                stop_time = std::chrono::high_resolution_clock::now();
+                time_declare += (stop_time - start_time);
+                declared_nodes += declared_refs.size();
+            }
         }
 
         // clear queue of non-reachable nodes and already winning nodes
@@ -447,38 +561,16 @@ void PGArena::constructArena(const bool parallel, const bool only_realizability,
                 already_queried.clear();
             }
 
-            if (exploration == ExplorationStrategy::BFS) {
-                filter_queue(queue_max, states, already_queried, new_declared_nodes, time_query, queried_nodes, unreachable_nodes_found, losing_nodes_found, winning_nodes_found, only_realizability);
-            }
-            else if (exploration == ExplorationStrategy::PQ) {
-                filter_queue(queue_max, states, already_queried, new_declared_nodes, time_query, queried_nodes, unreachable_nodes_found, losing_nodes_found, winning_nodes_found, only_realizability);
-                filter_queue(queue_min, states, already_queried, new_declared_nodes, time_query, queried_nodes, unreachable_nodes_found, losing_nodes_found, winning_nodes_found, only_realizability);
-            }
+            filter_queue(*queue, states, already_queried, new_declared_nodes, time_query, queried_nodes, unreachable_nodes_found, losing_nodes_found, winning_nodes_found, only_realizability);
 
             new_winning_nodes = false;
             new_declared_nodes = false;
         }
 
+        queue_sizes.add(queue->size());
         ScoredProductState scored_state;
-        if (exploration == ExplorationStrategy::BFS) {
-            scored_state = std::move(queue_max.top());
-            queue_max.pop();
-        }
-        else if (exploration == ExplorationStrategy::PQ) {
-            if (use_max_queue && !queue_max.empty()) {
-                scored_state = std::move(queue_max.top());
-                queue_max.pop();
-                use_max_queue = false;
-            }
-            else if (!queue_min.empty()) {
-                scored_state = std::move(queue_min.top());
-                queue_min.pop();
-                use_max_queue = true;
-            }
-            else {
-                use_max_queue = !use_max_queue;
-                continue;
-            }
+        if (!queue->pop(scored_state)) {
+            continue;
         }
 
         const node_id_t ref_id = scored_state.ref_id;
@@ -491,10 +583,24 @@ void PGArena::constructArena(const bool parallel, const bool only_realizability,
         env_node_map[ref_id] = env_node;
         env_node_to_ref_id.insert({ env_node, ref_id });
 
+        if (memory_limit > 0 && ++explored_since_check == MEMORY_CHECK_INTERVAL) {
+            // release product states to disk if above the memory limit, but only the
+            // prefix of explored or decided states, which are not in the queue any more
+            explored_since_check = 0;
+            while (cold_ref_ids < states.size() && env_node_map[cold_ref_ids] != NODE_NONE) {
+                cold_ref_ids++;
+            }
+            if (resident_memory() > memory_limit) {
+                states.spill(cold_ref_ids);
+            }
+        }
+
+        const product_state_t state = states.get(ref_id);
+
         if (verbosity >= 1) {
             std::cout << " [" << std::setw(4) << env_node << "] Computing successors for " << std::setw(4) << ref_id;
             std::cout << " (" << std::fixed << std::setprecision(3) << std::setw(6) << std::abs(scored_state.score) << ") = (";
-            for (const auto s : states[ref_id]) {
+            for (const auto s : state) {
                 if (s == NODE_TOP) {
                     std::cout << "  ⊤";
                 }
@@ -528,11 +634,11 @@ void PGArena::constructArena(const bool parallel, const bool only_realizability,
 
         std::map<node_id_t, BDD> env_successors;
 
-        for (letter_t i = 0; i < n_env_actions; i++) {
+        for (uint64_t i = 0; i < n_env_actions; i++) {
             // compute input letter
             letter_t relevant_input = 0;
             for (size_t b = 0; b < relevant_inputs.size(); b++) {
-                relevant_input |= ((i & ((letter_t)1 << b)) >> b) << relevant_inputs[b];
+                relevant_input |= (letter_t)((i >> b) & 1) << relevant_inputs[b];
             }
             SpecSeq<letter_t> input_letter(relevant_input, irrelevant_inputs_mask);
 
@@ -541,11 +647,11 @@ void PGArena::constructArena(const bool parallel, const bool only_realizability,
             std::map<Edge, BDD> sys_successors;
             edge_id_t cur_sys_node_n_sys_edges = 0;
 
-            for (letter_t o = 0; o < n_sys_actions; o++) {
+            for (uint64_t o = 0; o < n_sys_actions; o++) {
                 // compute output letter
                 letter_t relevant_output = 0;
                 for (size_t b = 0; b < relevant_outputs.size(); b++) {
-                    relevant_output |= ((o & ((letter_t)1 << b)) >> b) << relevant_outputs[b];
+                    relevant_output |= (letter_t)((o >> b) & 1) << relevant_outputs[b];
                 }
                 SpecSeq<letter_t> output_letter(relevant_output, irrelevant_outputs_mask);
 
@@ -553,28 +659,19 @@ void PGArena::constructArena(const bool parallel, const bool only_realizability,
                 letter_t letter = input_letter.number + (output_letter.number << n_inputs);
 
                 product_state_t new_state(product_state_size);
-                const ColorScore cs = structure.getSuccessor(states[ref_id], new_state, letter);
+                const ColorScore cs = structure->getSuccessor(state, new_state, letter);
                 const color_t color = cs.color;
 
                 node_id_t succ = env_node_map.size();
-                double score;
-
-                if (exploration == ExplorationStrategy::PQ) {
-                    score = cs.score;
-                    // decrease score for nodes discovered later to mix in BFS aspect
-                    constexpr double factor = 1.0 - pow(0.5, 6);
-                    score *= pow(factor, (double)(env_node / 100));
-                }
-                else { // exploration == ExplorationStrategy::BFS
-                    score = -(double)succ;
-                }
+                double score = queue->score(cs, succ, env_node);
 
-                if (!structure.isBottomState(new_state)) {
-                    if (structure.isTopState(new_state)) {
+                if (!structure->isBottomState(new_state)) {
+                    if (structure->isTopState(new_state)) {
                         succ = top_node_ref;
                     }
                     else {
-                        auto result = state_map.insert({ new_state, MinMaxState(score, succ) });
+                        states.push_back(new_state);
+                        auto result = state_map.insert(succ);
                         if (result.second) {
                             // new successor
                             if (
@@ -589,44 +686,29 @@ void PGArena::constructArena(const bool parallel, const bool only_realizability,
                                 has_lock = false;
                             }
                             env_node_reachable.push_back(true);
+                            min_scores.push_back(score);
+                            max_scores.push_back(score);
 
-                            states.push_back(std::move(new_state));
-
-                            if (exploration == ExplorationStrategy::BFS) {
-                                queue_max.push(ScoredProductState( score, succ));
-                            }
-                            else if (exploration == ExplorationStrategy::PQ) {
-                                queue_max.push(ScoredProductState( score, succ));
-                                queue_min.push(ScoredProductState(-score, succ));
-                            }
+                            queue->push(succ, score);
                         }
                         else {
                             // successor already seen
-                            succ = result.first->second.ref_id;
-                            double& succ_max_score = result.first->second.max_score;
-                            double& succ_min_score = result.first->second.min_score;
+                            states.pop_back();
+                            succ = *result.first;
+                            score = queue->score(cs, succ, env_node);
+                            double& succ_max_score = max_scores[succ];
+                            double& succ_min_score = min_scores[succ];
 
                             if (clear_queue && env_node_map[succ] == NODE_NONE && !env_node_reachable[succ]) {
                                 // node may have been removed from queue, need to add it again
                                 env_node_reachable[succ] = true;
-                                if (exploration == ExplorationStrategy::BFS) {
-                                    queue_max.push(ScoredProductState(-((double)succ) , succ));
-                                }
-                                else if (exploration == ExplorationStrategy::PQ) {
-                                    queue_max.push(ScoredProductState( score, succ));
-                                    queue_min.push(ScoredProductState(-score, succ));
-                                }
+                                queue->push(succ, score);
                             }
-                            else if (exploration == ExplorationStrategy::PQ && (score < succ_min_score || score > succ_max_score)) {
+                            else if (env_node_map[succ] == NODE_NONE && (score < succ_min_score || score > succ_max_score)) {
                                 // score of node in queue changed
-                                if (score > succ_max_score) {
-                                    succ_max_score = score;
-                                    queue_max.push(ScoredProductState( score, succ));
-                                }
-                                else if (score < succ_min_score) {
-                                    succ_min_score = score;
-                                    queue_min.push(ScoredProductState(-score, succ));
-                                }
+                                succ_max_score = std::max(succ_max_score, score);
+                                succ_min_score = std::min(succ_min_score, score);
+                                queue->rescore(succ, score);
                             }
                         }
                     }
@@ -638,7 +720,7 @@ void PGArena::constructArena(const bool parallel, const bool only_realizability,
                     else {
                         Edge edge(succ, color);
 
-                        if (true || !only_realizability) {
+                        if (!drop_labels) {
                             // add output to bdd
                             BDD output_bdd = output_letter.toBDD(manager_output_bdds, n_outputs);
 
@@ -705,7 +787,7 @@ void PGArena::constructArena(const bool parallel, const bool only_realizability,
                 sys_node = *result.first;
             }
 
-            if (true || !only_realizability) {
+            if (!drop_labels) {
                 // add input to bdd
                 BDD input_bdd = input_letter.toBDD(manager_input_bdds, n_inputs);
                 auto const result = env_successors.insert({ sys_node, input_bdd });
@@ -714,7 +796,7 @@ void PGArena::constructArena(const bool parallel, const bool only_realizability,
                 }
             }
             else {
-                env_successors[sys_node] = manager_output_bdds.bddOne();
+                env_successors[sys_node] = manager_input_bdds.bddOne();
             }
 
             cur_env_node_n_sys_edges += cur_sys_node_n_sys_edges;
@@ -764,11 +846,29 @@ void PGArena::constructArena(const bool parallel, const bool only_realizability,
     assert(n_sys_edges == sys_succs.size());
     assert(n_env_edges == env_succs.size());
 
+    Statistics::counter("arena.env_nodes").add(n_env_nodes);
+    Statistics::counter("arena.sys_nodes").add(n_sys_nodes);
+    Statistics::counter("arena.env_edges").add(n_env_edges);
+    Statistics::counter("arena.sys_edges").add(n_sys_edges);
+    Statistics::counter("arena.queried_nodes").add(queried_nodes);
+    Statistics::counter("arena.declared_nodes").add(declared_nodes);
+    Statistics::counter("arena.unreachable_nodes").add(unreachable_nodes_found);
+    Statistics::counter("arena.winning_nodes").add(winning_nodes_found);
+    Statistics::counter("arena.losing_nodes").add(losing_nodes_found);
+    Statistics::counter("arena.bytes_spilled").add(states.getBytesSpilled());
+    Statistics::timer("arena.reachability").add(time_reach);
+    Statistics::timer("arena.query").add(time_query);
+    Statistics::timer("arena.declare").add(time_declare);
+
     if (verbosity >= 2) {
         std::cout << " * Reachability analysis took " << std::fixed << std::setprecision(2) << time_reach.count() << " seconds." << std::endl;
         std::cout << " * Queries took " << std::fixed << std::setprecision(2) << time_query.count() << " seconds." << std::endl;
         std::cout << " * Declarations took " << std::fixed << std::setprecision(2) << time_declare.count() << " seconds." << std::endl;
         std::cout << " * Queried nodes: " << queried_nodes << std::endl;
+        std::cout << " * Declared nodes: " << declared_nodes << std::endl;
+        if (memory_limit > 0) {
+            std::cout << " * Bytes of product states spilled: " << states.getBytesSpilled() << std::endl;
+        }
         std::cout << " * Unreachable nodes found: " << unreachable_nodes_found << std::endl;
         std::cout << " * Winning nodes found: " << winning_nodes_found << std::endl;
         std::cout << " * Losing nodes found: " << losing_nodes_found << std::endl;
@@ -778,17 +878,19 @@ void PGArena::constructArena(const bool parallel, const bool only_realizability,
     complete = true;
     change.notify_all();
 
-    // fill vector for product states
-    product_states.resize(n_env_nodes);
-    for (auto& entry : state_map) {
-        const node_id_t node_id = env_node_map[entry.second.ref_id];
-        if (node_id != NODE_NONE && node_id != NODE_BOTTOM && node_id != NODE_TOP) {
-            product_states[node_id] = std::move(entry.first);
+    // fill vector for product states, only needed for product state labels
+    if (product_labels) {
+        product_states.resize(n_env_nodes);
+        for (node_id_t ref_id = 0; ref_id < states.size(); ref_id++) {
+            const node_id_t node_id = env_node_map[ref_id];
+            if (node_id != NODE_NONE && node_id != NODE_BOTTOM && node_id != NODE_TOP) {
+                product_states[node_id] = states.get(ref_id);
+            }
         }
     }
 
     // clear structure, not needed any more
-    //structure.clear();
+    //structure->clear();
 }
 
 void PGArena::print_basic_info() const {
@@ -13,17 +13,23 @@
 #include "util/Quine.h"
 #include "util/SpecSeq.h"
 #include "aut/ParityAutomatonTree.h"
+#include "pg/ExplorationQueue.h"
+#include "pg/StateStore.h"
 
 namespace pg {
 
 class PGArena {
 private:
-    aut::AutomatonTreeStructure& structure;
+    // structure for constructing the arena, or null if the arena was loaded from a file
+    aut::AutomatonTreeStructure* const structure;
     const ExplorationStrategy exploration;
     const bool clear_queue;
+    const size_t beam_width;
+    // limit on the resident memory in bytes before product states are spilled to disk, 0 if unbounded
+    const size_t memory_limit;
 
-    std::vector<letter_t> relevant_inputs;
-    std::vector<letter_t> relevant_outputs;
+    std::vector<size_t> relevant_inputs;
+    std::vector<size_t> relevant_outputs;
 
     letter_t unused_inputs_mask;
     letter_t unused_outputs_mask;
@@ -48,6 +54,9 @@ private:
     std::vector<Player> sys_winner;
     std::vector<Player> env_winner;
 
+    // whether the input and output labels of the edges are stored
+    bool has_labels;
+
     size_t product_state_size;
     std::vector<product_state_t> product_states;
     std::vector<SpecSeq<node_id_t>> state_labels;
@@ -59,68 +68,42 @@ private:
     Cudd manager_input_bdds;
     Cudd manager_output_bdds;
 
-    struct ScoredProductState {
-        double score;
-        node_id_t ref_id;
-
-        ScoredProductState() :
-            score(0.0),
-            ref_id(NODE_NONE)
-        {}
-        ScoredProductState(double score, node_id_t ref_id) :
-            score(score),
-            ref_id(ref_id)
-        {}
-    };
-
-    struct MinMaxState {
-        double min_score;
-        double max_score;
-        node_id_t ref_id;
-
-        MinMaxState(const ScoredProductState& product_state) :
-            min_score(product_state.score),
-            max_score(product_state.score),
-            ref_id(product_state.ref_id)
-        {}
-        MinMaxState(double score, node_id_t ref_id) :
-            min_score(score),
-            max_score(score),
-            ref_id(ref_id)
-        {}
-        MinMaxState(double min_score, double max_score, node_id_t ref_id) :
-            min_score(min_score),
-            max_score(max_score),
-            ref_id(ref_id)
-        {}
-    };
-
-    struct ScoredProductStateComparator {
-        bool operator() (ScoredProductState& s1, ScoredProductState& s2) {
-            return s1.score < s2.score;
-        }
-    };
-    template <class T, class Container = std::vector<T>, class Compare = std::less<T> >
-    class PQ : public std::priority_queue<T, Container, Compare> {
-    public:
-        Container& container() { return this->c; }
-    };
-    typedef PQ<ScoredProductState, std::deque<ScoredProductState>, ScoredProductStateComparator> state_queue;
-
-    void filter_queue(state_queue& queue, const std::vector<product_state_t>& states, std::unordered_set<node_id_t>& already_queried, const bool new_winning_nodes, std::chrono::duration<double>& time_query, size_t& queried_nodes, size_t& unreachable_found, size_t& losing_nodes_found, size_t& winning_nodes_found, const bool only_realizability);
+    void filter_queue(ExplorationQueue& queue, const StateStore& states, std::unordered_set<node_id_t>& already_queried, const bool new_winning_nodes, std::chrono::duration<double>& time_query, size_t& queried_nodes, size_t& unreachable_found, size_t& losing_nodes_found, size_t& winning_nodes_found, const bool only_realizability);
 
     void reachability_analysis();
 
+    PGArena(const size_t n_inputs, const size_t n_outputs, const Parity parity_type, const color_t n_colors);
+
 public:
     const size_t n_inputs;
     const size_t n_outputs;
 
-    PGArena(const size_t n_inputs, const size_t n_outputs, aut::AutomatonTreeStructure& structure, const ExplorationStrategy exploration, const bool clear_queue);
+    PGArena(const size_t n_inputs, const size_t n_outputs, aut::AutomatonTreeStructure& structure, const ExplorationStrategy exploration, const bool clear_queue, const size_t beam_width = 64, const size_t memory_limit = 0);
     ~PGArena();
 
-    void constructArena(const bool parallel = false, const bool only_realizability = false, const int verbosity = 0);
+    void constructArena(const bool parallel = false, const bool only_realizability = false, const bool product_labels = true, const int verbosity = 0);
     int computeStateLabels(std::vector<node_id_t>& visited_map, std::vector<int>& accumulated_bits);
 
+    // write the arena in binary format, can only be called after construction is complete
+    void writeGame(const std::string& filename, const std::vector<std::string>& inputs, const std::vector<std::string>& outputs) const;
+    // load an arena written by writeGame, with winners reset to unknown unless keep_winners is set
+    static std::unique_ptr<PGArena> loadGame(const std::string& filename, std::vector<std::string>& inputs, std::vector<std::string>& outputs, const bool keep_winners = false);
+
+    // load a parity game in PGSolver format, where player 0 is the system player,
+    // with the given initial node, or the start node of the game or node 0 if none is given
+    static std::unique_ptr<PGArena> loadPGSolverGame(const std::string& filename, node_id_t initial_id = NODE_NONE);
+    // build an arena from a parity game in PGSolver semantics, given by the priority and owner of each
+    // node and the successors of node i in succs[succs_begin[i]] to succs[succs_begin[i + 1] - 1]
+    static std::unique_ptr<PGArena> fromParityGame(
+            const std::vector<uint32_t>& priorities,
+            const std::vector<uint8_t>& owners,
+            const std::vector<edge_id_t>& succs_begin,
+            const std::vector<node_id_t>& succs,
+            const node_id_t initial_node
+    );
+
+    inline bool hasLabels() const { return has_labels; }
+
     // mutex for reading from or resizing the arena vectors
     std::mutex arena_mutex;
 
@@ -145,8 +128,8 @@ public:
     const node_id_t initial_node;
     node_id_t initial_node_ref;
 
-    letter_t n_env_actions;
-    letter_t n_sys_actions;
+    uint64_t n_env_actions;
+    uint64_t n_sys_actions;
 
     std::atomic<node_id_t> n_env_nodes;
     std::atomic<node_id_t> n_sys_nodes;
@@ -185,6 +168,8 @@ public:
     inline node_id_t getEnvEdge(edge_id_t env_edge) const { return env_succs[env_edge]; };
     inline BDD getEnvInput(edge_id_t env_edge) const { return env_input[env_edge]; }
 
+    inline const Cudd& getInputManager() const { return manager_input_bdds; }
+    inline const Cudd& getOutputManager() const { return manager_output_bdds; }
     inline BDD anyOutput() const { return manager_output_bdds.bddOne(); }
     inline BDD noOutput() const { return manager_output_bdds.bddZero(); }
     inline BDD anyInput() const { return manager_input_bdds.bddOne(); }
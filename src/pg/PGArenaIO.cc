@@ -0,0 +1,715 @@
+#include "PGArena.h"
+
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <cctype>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "util/BDDCover.h"
+
+/*
+ * Binary format for parity games.
+ *
+ * The file starts with a fixed header, followed by the arrays of the arena
+ * in the order they are written below. Every array is stored in native byte
+ * order and padded to a multiple of 8 bytes, so that it can be read directly
+ * from a memory-mapped file. Labels are stored as lists of cubes for each
+ * system edge followed by each environment edge. Letters, i.e. the masks and
+ * the cubes of the labels, are stored with the number of words given in the
+ * header, so that files can be exchanged between builds for different numbers
+ * of signals as long as the signals fit.
+ */
+
+namespace pg {
+
+namespace {
+
+constexpr char GAME_FILE_MAGIC[8] = { 'S', 'T', 'R', 'I', 'X', 'P', 'G', '\0' };
+constexpr uint32_t GAME_FILE_VERSION = 2;
+constexpr uint32_t GAME_FILE_LABELS = 1;
+constexpr size_t GAME_FILE_ALIGNMENT = 8;
+// true, false, unused and irrelevant masks of inputs and outputs
+constexpr size_t N_GAME_FILE_MASKS = 8;
+constexpr size_t GAME_FILE_BUFFER_SIZE = 1 << 20;
+
+struct GameFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint32_t parity_type;
+    uint32_t n_colors;
+    uint64_t n_inputs;
+    uint64_t n_outputs;
+    uint64_t n_env_nodes;
+    uint64_t n_sys_nodes;
+    uint64_t n_env_edges;
+    uint64_t n_sys_edges;
+    uint64_t n_refs;
+    uint64_t initial_node_ref;
+    uint64_t letter_words;
+    uint64_t names_size;
+    uint64_t labels_size;
+};
+
+static_assert(sizeof(GameFileHeader) % GAME_FILE_ALIGNMENT == 0, "header must be aligned");
+static_assert(std::is_trivially_copyable<Edge>::value, "edges must be trivially copyable");
+static_assert(sizeof(Player) == 1, "players must be stored in one byte");
+
+inline size_t padded_size(const size_t bytes) {
+    return (bytes + GAME_FILE_ALIGNMENT - 1) / GAME_FILE_ALIGNMENT * GAME_FILE_ALIGNMENT;
+}
+
+template <typename T>
+void write_section(std::ofstream& file, const T* data, const size_t n) {
+    static const char padding[GAME_FILE_ALIGNMENT] = {};
+    const size_t bytes = n * sizeof(T);
+    file.write(reinterpret_cast<const char*>(data), bytes);
+    file.write(padding, padded_size(bytes) - bytes);
+}
+
+inline void append_letter(std::vector<uint64_t>& words, const letter_t letter) {
+    for (size_t i = 0; i < LETTER_WORDS; i++) {
+        words.push_back(letter_word(letter, i));
+    }
+}
+
+// reads a letter of n_words words, which must fit into letter_t
+inline letter_t read_letter(const uint64_t* words, const size_t n_words) {
+    letter_t letter = 0;
+    for (size_t i = 0; i < n_words; i++) {
+        if (i >= LETTER_WORDS && words[i] != 0) {
+            throw std::runtime_error("Parity game file has more signals than supported");
+        }
+        set_letter_word(letter, i, words[i]);
+    }
+    return letter;
+}
+
+void append_cubes(std::vector<uint64_t>& labels, BDDCover<letter_t>& cover, const BDD& bdd) {
+    std::vector<SpecSeq<letter_t>> cubes;
+    cover.cover(bdd, cubes);
+    labels.push_back(cubes.size());
+    for (const SpecSeq<letter_t>& cube : cubes) {
+        append_letter(labels, cube.number);
+        append_letter(labels, cube.unspecifiedBits);
+    }
+}
+
+// read-only memory mapping of a whole file, read sequentially
+class MappedFile {
+private:
+    const char* mapping;
+    size_t mapping_size;
+
+public:
+    MappedFile(const std::string& filename) :
+        mapping(nullptr),
+        mapping_size(0)
+    {
+        const int fd = open(filename.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throw std::runtime_error("Could not open parity game file: " + filename);
+        }
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) != 0) {
+            close(fd);
+            throw std::runtime_error("Could not read parity game file: " + filename);
+        }
+        mapping_size = file_stat.st_size;
+        if (mapping_size > 0) {
+            void* m = mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("Could not map parity game file: " + filename);
+            }
+            madvise(m, mapping_size, MADV_SEQUENTIAL);
+            mapping = static_cast<const char*>(m);
+        }
+        close(fd);
+    }
+    ~MappedFile() {
+        if (mapping != nullptr) {
+            munmap(const_cast<char*>(mapping), mapping_size);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    inline const char* data() const { return mapping; }
+    inline size_t size() const { return mapping_size; }
+};
+
+class GameFileReader {
+private:
+    const char* const end;
+    const char* current;
+
+public:
+    GameFileReader(const char* begin, const size_t size) :
+        end(begin + size),
+        current(begin)
+    {}
+
+    // n is checked against the remaining size before any multiplication, so that
+    // corrupted counts cannot overflow the size computation
+    template <typename T>
+    const T* section(const uint64_t n) {
+        const size_t available = end - current;
+        if (n > available / sizeof(T)) {
+            throw std::runtime_error("Parity game file is truncated");
+        }
+        const size_t bytes = padded_size(n * sizeof(T));
+        if (bytes > available) {
+            throw std::runtime_error("Parity game file is truncated");
+        }
+        const T* data = reinterpret_cast<const T*>(current);
+        current += bytes;
+        return data;
+    }
+};
+
+// tokenizer for parity games in PGSolver format
+class PGSolverTokenizer {
+private:
+    const std::string& filename;
+    const char* current;
+    const char* const end;
+    size_t line;
+
+    inline void skip_space() {
+        while (current < end && std::isspace(static_cast<unsigned char>(*current))) {
+            if (*current == '\n') {
+                line++;
+            }
+            current++;
+        }
+    }
+
+public:
+    PGSolverTokenizer(const std::string& filename, const char* begin, const size_t size) :
+        filename(filename),
+        current(begin),
+        end(begin + size),
+        line(1)
+    {}
+
+    [[noreturn]] void error(const std::string& message) const {
+        throw std::runtime_error("Invalid parity game in " + filename + " at line " + std::to_string(line) + ": " + message);
+    }
+
+    inline bool done() {
+        skip_space();
+        return current == end;
+    }
+
+    inline bool accept(const char c) {
+        skip_space();
+        if (current < end && *current == c) {
+            current++;
+            return true;
+        }
+        return false;
+    }
+
+    inline void expect(const char c) {
+        if (!accept(c)) {
+            error(std::string("expected '") + c + "'");
+        }
+    }
+
+    bool accept_keyword(const char* keyword) {
+        skip_space();
+        const size_t length = std::strlen(keyword);
+        if ((size_t)(end - current) >= length && std::memcmp(current, keyword, length) == 0 &&
+                (current + length == end || !std::isalnum(static_cast<unsigned char>(current[length])))) {
+            current += length;
+            return true;
+        }
+        return false;
+    }
+
+    uint32_t number() {
+        skip_space();
+        if (current == end || !std::isdigit(static_cast<unsigned char>(*current))) {
+            error("expected number");
+        }
+        uint64_t value = 0;
+        while (current < end && std::isdigit(static_cast<unsigned char>(*current))) {
+            value = 10 * value + (*current - '0');
+            if (value >= std::numeric_limits<uint32_t>::max()) {
+                error("number too large");
+            }
+            current++;
+        }
+        return value;
+    }
+
+    // skip an optional quoted name
+    void skip_name() {
+        skip_space();
+        if (current < end && *current == '"') {
+            current++;
+            while (current < end && *current != '"') {
+                if (*current == '\n') {
+                    line++;
+                }
+                current++;
+            }
+            if (current == end) {
+                error("unterminated name");
+            }
+            current++;
+        }
+    }
+};
+
+}
+
+void PGArena::writeGame(const std::string& filename, const std::vector<std::string>& inputs, const std::vector<std::string>& outputs) const {
+    assert(complete);
+
+    std::vector<char> names;
+    for (const auto& name : inputs) {
+        names.insert(names.end(), name.cbegin(), name.cend());
+        names.push_back('\0');
+    }
+    for (const auto& name : outputs) {
+        names.insert(names.end(), name.cbegin(), name.cend());
+        names.push_back('\0');
+    }
+
+    std::vector<uint64_t> labels;
+    if (has_labels) {
+        labels.reserve((1 + 2 * LETTER_WORDS) * (sys_succs.size() + env_succs.size()));
+        BDDCover<letter_t> output_cover(manager_output_bdds, n_outputs);
+        BDDCover<letter_t> input_cover(manager_input_bdds, n_inputs);
+        for (const BDD& output : sys_output) {
+            append_cubes(labels, output_cover, output);
+        }
+        for (const BDD& input : env_input) {
+            append_cubes(labels, input_cover, input);
+        }
+    }
+
+    GameFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, GAME_FILE_MAGIC, sizeof(header.magic));
+    header.version = GAME_FILE_VERSION;
+    header.flags = has_labels ? GAME_FILE_LABELS : 0;
+    header.parity_type = parity_type;
+    header.n_colors = n_colors;
+    header.n_inputs = n_inputs;
+    header.n_outputs = n_outputs;
+    header.n_env_nodes = n_env_nodes;
+    header.n_sys_nodes = n_sys_nodes;
+    header.n_env_edges = env_succs.size();
+    header.n_sys_edges = sys_succs.size();
+    header.n_refs = env_node_map.size();
+    header.initial_node_ref = initial_node_ref;
+    header.letter_words = LETTER_WORDS;
+    header.names_size = names.size();
+    header.labels_size = labels.size();
+
+    std::vector<char> buffer(GAME_FILE_BUFFER_SIZE);
+    std::ofstream file;
+    file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Could not open parity game file: " + filename);
+    }
+
+    std::vector<uint64_t> masks;
+    for (const letter_t mask : { true_inputs_mask, false_inputs_mask, unused_inputs_mask, irrelevant_inputs_mask,
+            true_outputs_mask, false_outputs_mask, unused_outputs_mask, irrelevant_outputs_mask }) {
+        append_letter(masks, mask);
+    }
+
+    write_section(file, &header, 1);
+    write_section(file, masks.data(), masks.size());
+    write_section(file, sys_succs_begin.data(), sys_succs_begin.size());
+    write_section(file, sys_succs.data(), sys_succs.size());
+    write_section(file, env_succs_begin.data(), env_succs_begin.size());
+    write_section(file, env_succs.data(), env_succs.size());
+    write_section(file, env_node_map.data(), env_node_map.size());
+    write_section(file, sys_winner.data(), sys_winner.size());
+    write_section(file, env_winner.data(), env_winner.size());
+    write_section(file, names.data(), names.size());
+    write_section(file, labels.data(), labels.size());
+
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Could not write parity game file: " + filename);
+    }
+}
+
+std::unique_ptr<PGArena> PGArena::loadGame(const std::string& filename, std::vector<std::string>& inputs, std::vector<std::string>& outputs, const bool keep_winners) {
+    const MappedFile file(filename);
+    if (file.size() < sizeof(GameFileHeader)) {
+        throw std::runtime_error("Invalid parity game file: " + filename);
+    }
+
+    GameFileReader reader(file.data(), file.size());
+    const GameFileHeader& header = *reader.section<GameFileHeader>(1);
+    if (std::memcmp(header.magic, GAME_FILE_MAGIC, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("Invalid parity game file: " + filename);
+    }
+    if (header.version != GAME_FILE_VERSION) {
+        throw std::runtime_error("Unsupported parity game file version " + std::to_string(header.version) + ": " + filename);
+    }
+    if (header.n_env_nodes == 0 || header.parity_type > Parity::ODD || header.letter_words == 0 || header.letter_words > file.size()) {
+        throw std::runtime_error("Invalid parity game file: " + filename);
+    }
+    // node and edge ids have to fit below the special values, which also keeps the counts plus one from overflowing
+    if (
+            header.n_env_nodes >= NODE_NONE_TOP || header.n_sys_nodes >= NODE_NONE_TOP || header.n_refs >= NODE_NONE_TOP ||
+            header.n_env_edges >= EDGE_BOTTOM || header.n_sys_edges >= EDGE_BOTTOM || header.initial_node_ref >= header.n_refs
+    ) {
+        throw std::runtime_error("Invalid parity game file: " + filename);
+    }
+    if (header.n_inputs > LETTER_BITS || header.n_outputs > LETTER_BITS) {
+        throw std::runtime_error("Parity game file has more signals than supported, rebuild with a larger MAX_SIGNALS: " + filename);
+    }
+
+    std::unique_ptr<PGArena> arena(new PGArena(header.n_inputs, header.n_outputs, (Parity)header.parity_type, header.n_colors));
+    PGArena& a = *arena;
+
+    const size_t letter_words = header.letter_words;
+    const uint64_t* masks = reader.section<uint64_t>(N_GAME_FILE_MASKS * letter_words);
+    const edge_id_t* sys_succs_begin = reader.section<edge_id_t>(header.n_sys_nodes + 1);
+    const Edge* sys_succs = reader.section<Edge>(header.n_sys_edges);
+    const edge_id_t* env_succs_begin = reader.section<edge_id_t>(header.n_env_nodes + 1);
+    const node_id_t* env_succs = reader.section<node_id_t>(header.n_env_edges);
+    const node_id_t* env_node_map = reader.section<node_id_t>(header.n_refs);
+    const Player* sys_winner = reader.section<Player>(header.n_sys_nodes);
+    const Player* env_winner = reader.section<Player>(header.n_env_nodes);
+    const char* names = reader.section<char>(header.names_size);
+    const uint64_t* labels = reader.section<uint64_t>(header.labels_size);
+
+    // edge ranges of the nodes start at zero, are monotone and end at the number of edges
+    auto check_succs_begin = [&](const edge_id_t* succs_begin, const uint64_t n_nodes, const uint64_t n_edges) {
+        if (succs_begin[0] != 0 || succs_begin[n_nodes] != n_edges) {
+            throw std::runtime_error("Inconsistent parity game file: " + filename);
+        }
+        for (uint64_t n = 0; n < n_nodes; n++) {
+            if (succs_begin[n] > succs_begin[n + 1]) {
+                throw std::runtime_error("Inconsistent parity game file: " + filename);
+            }
+        }
+    };
+    check_succs_begin(sys_succs_begin, header.n_sys_nodes, header.n_sys_edges);
+    check_succs_begin(env_succs_begin, header.n_env_nodes, header.n_env_edges);
+    for (size_t r = 0; r < header.n_refs; r++) {
+        const node_id_t node = env_node_map[r];
+        if (
+                node >= header.n_env_nodes && node != NODE_TOP && node != NODE_BOTTOM &&
+                node != NODE_NONE && node != NODE_NONE_TOP && node != NODE_NONE_BOTTOM
+        ) {
+            throw std::runtime_error("Inconsistent parity game file: " + filename);
+        }
+    }
+    for (size_t e = 0; e < header.n_sys_edges; e++) {
+        if (sys_succs[e].successor >= header.n_refs || sys_succs[e].color >= header.n_colors) {
+            throw std::runtime_error("Inconsistent parity game file: " + filename);
+        }
+    }
+    for (size_t e = 0; e < header.n_env_edges; e++) {
+        if (env_succs[e] >= header.n_sys_nodes) {
+            throw std::runtime_error("Inconsistent parity game file: " + filename);
+        }
+    }
+
+    // bulk copy of the arrays from the mapped file
+    a.sys_succs_begin.assign(sys_succs_begin, sys_succs_begin + header.n_sys_nodes + 1);
+    a.sys_succs.assign(sys_succs, sys_succs + header.n_sys_edges);
+    a.env_succs_begin.assign(env_succs_begin, env_succs_begin + header.n_env_nodes + 1);
+    a.env_succs.assign(env_succs, env_succs + header.n_env_edges);
+    a.env_node_map.assign(env_node_map, env_node_map + header.n_refs);
+    a.env_node_reachable.assign(header.n_refs, true);
+    if (keep_winners) {
+        a.sys_winner.assign(sys_winner, sys_winner + header.n_sys_nodes);
+        a.env_winner.assign(env_winner, env_winner + header.n_env_nodes);
+    }
+    else {
+        a.sys_winner.assign(header.n_sys_nodes, Player::UNKNOWN);
+        a.env_winner.assign(header.n_env_nodes, Player::UNKNOWN);
+    }
+
+    inputs.clear();
+    outputs.clear();
+    const char* name = names;
+    const char* const names_end = names + header.names_size;
+    while (name < names_end) {
+        const size_t length = strnlen(name, names_end - name);
+        if (inputs.size() < header.n_inputs) {
+            inputs.emplace_back(name, length);
+        }
+        else {
+            outputs.emplace_back(name, length);
+        }
+        name += length + 1;
+    }
+    if (inputs.size() != header.n_inputs || outputs.size() != header.n_outputs) {
+        throw std::runtime_error("Inconsistent parity game file: " + filename);
+    }
+
+    a.has_labels = (header.flags & GAME_FILE_LABELS) != 0;
+    a.sys_output.reserve(header.n_sys_edges);
+    a.env_input.reserve(header.n_env_edges);
+    if (a.has_labels) {
+        size_t i = 0;
+        auto read_label = [&](const Cudd& manager, const int n_bits) {
+            if (i >= header.labels_size) {
+                throw std::runtime_error("Parity game file is truncated");
+            }
+            const uint64_t n_cubes = labels[i++];
+            if (n_cubes > (header.labels_size - i) / (2 * letter_words)) {
+                throw std::runtime_error("Parity game file is truncated");
+            }
+            BDD bdd = manager.bddZero();
+            for (uint64_t c = 0; c < n_cubes; c++) {
+                SpecSeq<letter_t> cube(read_letter(labels + i, letter_words), read_letter(labels + i + letter_words, letter_words));
+                bdd |= cube.toBDD(manager, n_bits);
+                i += 2 * letter_words;
+            }
+            return bdd;
+        };
+        for (size_t e = 0; e < header.n_sys_edges; e++) {
+            a.sys_output.push_back(read_label(a.manager_output_bdds, header.n_outputs));
+        }
+        for (size_t e = 0; e < header.n_env_edges; e++) {
+            a.env_input.push_back(read_label(a.manager_input_bdds, header.n_inputs));
+        }
+    }
+    else {
+        a.sys_output.assign(header.n_sys_edges, a.manager_output_bdds.bddOne());
+        a.env_input.assign(header.n_env_edges, a.manager_input_bdds.bddOne());
+    }
+
+    a.true_inputs_mask = read_letter(masks, letter_words);
+    a.false_inputs_mask = read_letter(masks + letter_words, letter_words);
+    a.unused_inputs_mask = read_letter(masks + 2 * letter_words, letter_words);
+    a.irrelevant_inputs_mask = read_letter(masks + 3 * letter_words, letter_words);
+    a.true_outputs_mask = read_letter(masks + 4 * letter_words, letter_words);
+    a.false_outputs_mask = read_letter(masks + 5 * letter_words, letter_words);
+    a.unused_outputs_mask = read_letter(masks + 6 * letter_words, letter_words);
+    a.irrelevant_outputs_mask = read_letter(masks + 7 * letter_words, letter_words);
+
+    a.initial_node_ref = header.initial_node_ref;
+    a.n_env_nodes = header.n_env_nodes;
+    a.n_sys_nodes = header.n_sys_nodes;
+    a.n_env_edges = header.n_env_edges;
+    a.n_sys_edges = header.n_sys_edges;
+    a.complete = true;
+
+    return arena;
+}
+
+std::unique_ptr<PGArena> PGArena::loadPGSolverGame(const std::string& filename, node_id_t initial_id) {
+    const MappedFile file(filename);
+    PGSolverTokenizer tokenizer(filename, file.data(), file.size());
+
+    // nodes in order of declaration
+    std::vector<node_id_t> node_ids;
+    std::vector<uint32_t> priorities;
+    std::vector<uint8_t> owners;
+    std::vector<edge_id_t> succs_begin;
+    std::vector<node_id_t> succs;
+    // map from ids in the file to nodes
+    std::vector<node_id_t> node_index;
+
+    if (tokenizer.accept_keyword("parity")) {
+        const uint32_t max_id = tokenizer.number();
+        tokenizer.expect(';');
+        node_ids.reserve(max_id + 1);
+        node_index.reserve(max_id + 1);
+    }
+    if (tokenizer.accept_keyword("start")) {
+        const node_id_t start_id = tokenizer.number();
+        tokenizer.expect(';');
+        if (initial_id == NODE_NONE) {
+            initial_id = start_id;
+        }
+    }
+    if (initial_id == NODE_NONE) {
+        initial_id = 0;
+    }
+
+    succs_begin.push_back(0);
+    while (!tokenizer.done()) {
+        const node_id_t id = tokenizer.number();
+        const uint32_t priority = tokenizer.number();
+        const uint32_t owner = tokenizer.number();
+        if (owner > 1) {
+            tokenizer.error("invalid owner " + std::to_string(owner));
+        }
+        if (id >= node_index.size()) {
+            node_index.resize(id + 1, NODE_NONE);
+        }
+        if (node_index[id] != NODE_NONE) {
+            tokenizer.error("duplicate node " + std::to_string(id));
+        }
+        node_index[id] = node_ids.size();
+        node_ids.push_back(id);
+        priorities.push_back(priority);
+        owners.push_back(owner);
+        do {
+            succs.push_back(tokenizer.number());
+        } while (tokenizer.accept(','));
+        tokenizer.skip_name();
+        tokenizer.expect(';');
+        succs_begin.push_back(succs.size());
+    }
+
+    if (initial_id >= node_index.size() || node_index[initial_id] == NODE_NONE) {
+        throw std::runtime_error("Initial node " + std::to_string(initial_id) + " not found in parity game " + filename);
+    }
+    for (node_id_t& succ : succs) {
+        if (succ >= node_index.size() || node_index[succ] == NODE_NONE) {
+            throw std::runtime_error("Successor " + std::to_string(succ) + " not found in parity game " + filename);
+        }
+        succ = node_index[succ];
+    }
+
+    return fromParityGame(priorities, owners, succs_begin, succs, node_index[initial_id]);
+}
+
+std::unique_ptr<PGArena> PGArena::fromParityGame(
+        const std::vector<uint32_t>& priorities,
+        const std::vector<uint8_t>& owners,
+        const std::vector<edge_id_t>& succs_begin,
+        const std::vector<node_id_t>& succs,
+        const node_id_t initial_node
+) {
+    const node_id_t n_nodes = priorities.size();
+    if (n_nodes == 0 || owners.size() != n_nodes || succs_begin.size() != (size_t)n_nodes + 1 || succs_begin.back() != succs.size()) {
+        throw std::invalid_argument("Inconsistent sizes of parity game");
+    }
+    if (initial_node >= n_nodes) {
+        throw std::invalid_argument("Initial node " + std::to_string(initial_node) + " not in parity game");
+    }
+    for (const node_id_t succ : succs) {
+        if (succ >= n_nodes) {
+            throw std::invalid_argument("Successor " + std::to_string(succ) + " not in parity game");
+        }
+    }
+
+    // compress priorities, merging neighbouring priorities of the same parity
+    std::vector<uint32_t> sorted_priorities(priorities);
+    std::sort(sorted_priorities.begin(), sorted_priorities.end());
+    sorted_priorities.erase(std::unique(sorted_priorities.begin(), sorted_priorities.end()), sorted_priorities.end());
+    std::vector<uint32_t> compressed(sorted_priorities.size());
+    uint32_t max_priority = 0;
+    for (size_t i = 0; i < sorted_priorities.size(); i++) {
+        if (i == 0) {
+            max_priority = sorted_priorities[0] & 1;
+        }
+        else if ((max_priority & 1) != (sorted_priorities[i] & 1)) {
+            max_priority++;
+        }
+        compressed[i] = max_priority;
+    }
+    // highest priority is most significant, but lowest color, with the same parity
+    if (max_priority % 2 != 0) {
+        max_priority++;
+    }
+    auto color = [&](const node_id_t node) {
+        const size_t i = std::lower_bound(sorted_priorities.cbegin(), sorted_priorities.cend(), priorities[node]) - sorted_priorities.cbegin();
+        return (color_t)(max_priority - compressed[i]);
+    };
+
+    // the initial node has to be the first environment node
+    std::vector<node_id_t> env_node(n_nodes);
+    for (node_id_t i = 0; i < n_nodes; i++) {
+        env_node[i] = i;
+    }
+    std::swap(env_node[0], env_node[initial_node]);
+    std::vector<node_id_t> node_of(n_nodes);
+    for (node_id_t i = 0; i < n_nodes; i++) {
+        node_of[env_node[i]] = i;
+    }
+
+    // player 0 is the system player, which wins even priorities
+    std::unique_ptr<PGArena> arena(new PGArena(0, 0, Parity::EVEN, max_priority + 1));
+    PGArena& a = *arena;
+
+    // references of nodes are the environment nodes, followed by a reference for the top node
+    const node_id_t top_ref = n_nodes;
+    a.env_node_map.resize(n_nodes + 1);
+    for (node_id_t i = 0; i < n_nodes; i++) {
+        a.env_node_map[i] = i;
+    }
+    a.env_node_map[top_ref] = NODE_TOP;
+    a.env_node_reachable.assign(n_nodes + 1, true);
+
+    // system nodes 0 to n_nodes - 1 enter the corresponding environment node,
+    // system node n_nodes enters the top node for environment nodes without successors
+    a.sys_succs_begin.reserve(n_nodes + 2);
+    a.sys_succs.reserve(n_nodes + 1 + succs.size());
+    a.sys_succs_begin.push_back(0);
+    for (node_id_t e = 0; e < n_nodes; e++) {
+        a.sys_succs.push_back(Edge(e, color(node_of[e])));
+        a.sys_succs_begin.push_back(a.sys_succs.size());
+    }
+    const node_id_t top_sys_node = n_nodes;
+    a.sys_succs.push_back(Edge(top_ref, 0));
+    a.sys_succs_begin.push_back(a.sys_succs.size());
+
+    // environment nodes owned by player 1 choose the system node entering the successor,
+    // those owned by player 0 move to a system node choosing the successor
+    std::vector<node_id_t> successors;
+    a.env_succs_begin.reserve(n_nodes + 1);
+    a.env_succs_begin.push_back(0);
+    for (node_id_t e = 0; e < n_nodes; e++) {
+        const node_id_t node = node_of[e];
+        successors.clear();
+        for (edge_id_t j = succs_begin[node]; j != succs_begin[node + 1]; j++) {
+            successors.push_back(env_node[succs[j]]);
+        }
+        std::sort(successors.begin(), successors.end());
+        successors.erase(std::unique(successors.begin(), successors.end()), successors.end());
+
+        if (owners[node] == 1) {
+            if (successors.empty()) {
+                a.env_succs.push_back(top_sys_node);
+            }
+            else {
+                a.env_succs.insert(a.env_succs.end(), successors.cbegin(), successors.cend());
+            }
+        }
+        else {
+            a.env_succs.push_back(a.sys_succs_begin.size() - 1);
+            for (const node_id_t succ : successors) {
+                a.sys_succs.push_back(Edge(succ, color(node_of[succ])));
+            }
+            a.sys_succs_begin.push_back(a.sys_succs.size());
+        }
+        a.env_succs_begin.push_back(a.env_succs.size());
+    }
+
+    const node_id_t n_sys_nodes = a.sys_succs_begin.size() - 1;
+    a.sys_winner.assign(n_sys_nodes, Player::UNKNOWN);
+    a.env_winner.assign(n_nodes, Player::UNKNOWN);
+    a.sys_output.assign(a.sys_succs.size(), a.manager_output_bdds.bddOne());
+    a.env_input.assign(a.env_succs.size(), a.manager_input_bdds.bddOne());
+    a.has_labels = false;
+
+    a.initial_node_ref = 0;
+    a.n_env_nodes = n_nodes;
+    a.n_sys_nodes = n_sys_nodes;
+    a.n_env_edges = a.env_succs.size();
+    a.n_sys_edges = a.sys_succs.size();
+    a.complete = true;
+
+    return arena;
+}
+
+}
@@ -2,8 +2,16 @@
 
 #include <iomanip>
 
+#include "util/Statistics.h"
+
 namespace pg {
 
+// add the change of the phase statistics since the given snapshot to the global statistics
+static void publish_phase_statistics(const std::string& name, const PhaseStatistics& stats, const PhaseStatistics& snapshot) {
+    Statistics::timer("solver." + name).add(stats.time - snapshot.time, stats.executions - snapshot.executions);
+    Statistics::counter("solver." + name + ".edges").add(stats.edges - snapshot.edges);
+}
+
 inline distance_t PGSISolver::color_distance_delta(const color_t& color) {
     return 1 - (((arena.parity_type + color) & 1) << 1);
 }
@@ -18,14 +26,27 @@ template <Player P>
 void PGSISolver::strategy_iteration() {
     print_values_debug();
 
+    const size_t n_edges = (size_t)n_sys_edges + (size_t)n_env_edges;
     bool change = true;
     while (change && winner == UNKNOWN) {
+        auto start_time = std::chrono::steady_clock::now();
         bellman_ford<P>();
+        bellman_ford_stats.time += std::chrono::steady_clock::now() - start_time;
+
         print_debug("Executing strategy improvement…");
+        start_time = std::chrono::steady_clock::now();
         change = strategy_improvement<P>();
+        strategy_improvement_stats.time += std::chrono::steady_clock::now() - start_time;
+        strategy_improvement_stats.executions++;
+        strategy_improvement_stats.edges += n_edges;
         print_values_debug();
+
         print_debug("Marking solved nodes");
+        start_time = std::chrono::steady_clock::now();
         update_nodes<P>();
+        update_nodes_stats.time += std::chrono::steady_clock::now() - start_time;
+        update_nodes_stats.executions++;
+        update_nodes_stats.edges += n_sys_edges;
         print_values_debug();
     }
 }
@@ -71,6 +92,9 @@ void PGSISolver::bellman_ford() {
     print_values_debug();
     bool change = true;
     while (change) {
+        // each iteration relaxes all system and environment edges
+        bellman_ford_stats.executions++;
+        bellman_ford_stats.edges += (size_t)n_sys_edges + (size_t)n_env_edges;
         print_debug("Executing Bellman-Ford iteration…");
         if constexpr(P == SYS_PLAYER) {
             bellman_ford_sys_iteration<P>();
@@ -440,6 +464,10 @@ inline void PGSISolver::print_values_debug() {
 }
 
 void PGSISolver::solve_game() {
+    const PhaseStatistics bellman_ford_snapshot = bellman_ford_stats;
+    const PhaseStatistics strategy_improvement_snapshot = strategy_improvement_stats;
+    const PhaseStatistics update_nodes_snapshot = update_nodes_stats;
+
     sys_distances = std::vector<distance_t>(n_sys_nodes * n_colors, 0);
     env_distances = std::vector<distance_t>(n_env_nodes * n_colors, 0);
 
@@ -451,6 +479,12 @@ void PGSISolver::solve_game() {
     print_debug("Starting strategy iteration for env player…");
     strategy_iteration<ENV_PLAYER>();
 
+    Statistics::counter("solver.rounds").add();
+    Statistics::histogram("solver.iterations_per_round").add(strategy_improvement_stats.executions - strategy_improvement_snapshot.executions);
+    publish_phase_statistics("bellman_ford", bellman_ford_stats, bellman_ford_snapshot);
+    publish_phase_statistics("strategy_improvement", strategy_improvement_stats, strategy_improvement_snapshot);
+    publish_phase_statistics("update_nodes", update_nodes_stats, update_nodes_snapshot);
+
     // clear memory
     std::vector<distance_t>().swap(sys_distances);
     std::vector<distance_t>().swap(env_distances);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 #include "pg/PGArena.h"
 #include "pg/PGSolver.h"
 
@@ -14,11 +16,24 @@ static_assert(DISTANCE_INFINITY + 1 > 0, "plus infinity too large");
 static_assert(DISTANCE_MINUS_INFINITY < 0, "minus infinity not negative");
 static_assert(DISTANCE_MINUS_INFINITY - 1 < 0, "minus infinity too small");
 
+// accumulated statistics of one phase of the solver
+struct PhaseStatistics {
+    std::chrono::duration<double> time = std::chrono::duration<double>::zero();
+    // number of executions, or of iterations for Bellman-Ford
+    size_t executions = 0;
+    // number of edges of the arena traversed during all executions
+    size_t edges = 0;
+};
+
 class PGSISolver : public PGSolver {
 private:
     std::vector<distance_t> sys_distances;
     std::vector<distance_t> env_distances;
 
+    PhaseStatistics bellman_ford_stats;
+    PhaseStatistics strategy_improvement_stats;
+    PhaseStatistics update_nodes_stats;
+
     inline distance_t color_distance_delta(const color_t& color);
 
     template <Player P>
@@ -44,6 +59,10 @@ protected:
 public:
     PGSISolver(pg::PGArena& arena, const bool onthefly_construction, const int num_threads, const bool compact_colors = true, const int verbositiy = 0);
     ~PGSISolver();
+
+    inline const PhaseStatistics& getBellmanFordStatistics() const { return bellman_ford_stats; }
+    inline const PhaseStatistics& getStrategyImprovementStatistics() const { return strategy_improvement_stats; }
+    inline const PhaseStatistics& getUpdateNodesStatistics() const { return update_nodes_stats; }
 };
 
 }
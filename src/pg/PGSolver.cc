@@ -8,6 +8,9 @@
 #include "omp.h"
 #include "cuddObj.hh"
 
+#include "util/BDDCover.h"
+#include "util/Profiler.h"
+
 namespace pg {
 
 PGSolver::PGSolver(pg::PGArena& arena, const bool onthefly_construction, const int num_threads, const bool compact_colors, const int verbosity) :
@@ -76,6 +79,7 @@ void PGSolver::copy_colors() {
 }
 
 void PGSolver::solve() {
+    PROFILE_ZONE("PGSolver::solve");
     // set number of threads for parallel solving
     int max_threads;
     if (num_threads > 0) {
@@ -149,12 +153,17 @@ static bool fun_add_product_labels(PGArena& arena, std::vector<node_id_t>& state
 }
 
 bool PGSolver::constructMooreMachine(mealy::MealyMachine& m, const bool add_product_labels) const {
+    PROFILE_ZONE("constructMooreMachine");
     mealy::machine_t machine;
 
     const SpecSeq<letter_t> any_input = true_clause<letter_t>(arena.n_inputs);
     const SpecSeq<letter_t> any_output = true_clause<letter_t>(arena.n_outputs);
     std::vector<node_id_t> state_map(n_env_nodes, NODE_NONE);
 
+    // covers are cached across all edges
+    BDDCover<letter_t> input_cover(arena.getInputManager(), arena.n_inputs);
+    BDDCover<letter_t> output_cover(arena.getOutputManager(), arena.n_outputs);
+
     std::deque<node_id_t> queue;
     queue.push_back(arena.initial_node);
     machine.push_back({});
@@ -172,10 +181,10 @@ bool PGSolver::constructMooreMachine(mealy::MealyMachine& m, const bool add_prod
 
         BDD input_bdd = arena.getEnvInput(env_edge);
         std::vector<SpecSeq<letter_t>> inputs;
-        for (BDDtoSpecSeqIterator<letter_t> in_it(input_bdd, arena.n_inputs); !in_it.done(); in_it++) {
+        input_cover.cover(input_bdd, inputs);
+        for (SpecSeq<letter_t>& input_letter : inputs) {
             // add constant inputs
-            SpecSeq<letter_t> input_letter = arena.addUnrealizableInputMask(*in_it);
-            inputs.push_back(input_letter);
+            input_letter = arena.addUnrealizableInputMask(input_letter);
         }
 
         const node_id_t sys_node = arena.getEnvEdge(env_edge);
@@ -213,9 +222,12 @@ bool PGSolver::constructMooreMachine(mealy::MealyMachine& m, const bool add_prod
             output_list.insert({ top_successor, !covered_outputs });
         }
 
+        std::vector<SpecSeq<letter_t>> cubes;
         for (const auto& entry : output_list) {
-            for (BDDtoSpecSeqIterator<letter_t> out_it(entry.second, arena.n_outputs); !out_it.done(); out_it++) {
-                machine[state].push_back( mealy::Transition(entry.first.successor, *out_it, entry.first.output) );
+            cubes.clear();
+            output_cover.cover(entry.second, cubes);
+            for (const SpecSeq<letter_t>& cube : cubes) {
+                machine[state].push_back( mealy::Transition(entry.first.successor, cube, entry.first.output) );
             }
         }
     }
@@ -249,12 +261,17 @@ bool PGSolver::constructMooreMachine(mealy::MealyMachine& m, const bool add_prod
 }
 
 bool PGSolver::constructMealyMachine(mealy::MealyMachine& m, const bool add_product_labels) const {
+    PROFILE_ZONE("constructMealyMachine");
     mealy::machine_t machine;
 
     const SpecSeq<letter_t> any_input = true_clause<letter_t>(arena.n_inputs);
     const SpecSeq<letter_t> any_output = true_clause<letter_t>(arena.n_outputs);
     std::vector<node_id_t> state_map(n_env_nodes, NODE_NONE);
 
+    // covers are cached across all edges
+    BDDCover<letter_t> input_cover(arena.getInputManager(), arena.n_inputs);
+    BDDCover<letter_t> output_cover(arena.getOutputManager(), arena.n_outputs);
+
     std::deque<node_id_t> queue;
     queue.push_back(arena.initial_node);
     machine.push_back({});
@@ -290,7 +307,7 @@ bool PGSolver::constructMealyMachine(mealy::MealyMachine& m, const bool add_prod
 
             auto succ_it = successor_list.begin();
             bool succ_explored = false;
-            size_t succ_num_outputs = 0;
+            double succ_num_outputs = 0.0;
 
             for (auto it = successor_list.begin(); it != successor_list.end(); it++) {
                 const node_id_t cur_successor = it->first;
@@ -301,7 +318,7 @@ bool PGSolver::constructMealyMachine(mealy::MealyMachine& m, const bool add_prod
                 }
                 else {
                     bool cur_succ_explored = (state_map[cur_successor] != NODE_NONE);
-                    size_t cur_succ_num_outputs = it->second.CountMinterm(arena.n_outputs);
+                    double cur_succ_num_outputs = output_cover.density(it->second);
                     if (
                             (cur_succ_explored && !succ_explored) ||
                             (cur_succ_explored == succ_explored && cur_succ_num_outputs > succ_num_outputs)
@@ -332,10 +349,10 @@ bool PGSolver::constructMealyMachine(mealy::MealyMachine& m, const bool add_prod
             // add outputs to state
             BDD output_bdd = succ_it->second;
             std::vector<SpecSeq<letter_t>> outputs;
-            for (BDDtoSpecSeqIterator<letter_t> out_it(output_bdd, arena.n_outputs); !out_it.done(); out_it++) {
+            output_cover.cover(output_bdd, outputs);
+            for (SpecSeq<letter_t>& output_letter : outputs) {
                 // add constant outputs
-                SpecSeq<letter_t> output_letter = arena.addRealizableOutputMask(*out_it);
-                outputs.push_back(output_letter);
+                output_letter = arena.addRealizableOutputMask(output_letter);
             }
             // sort outputs by number of unspecified bits and number of zeros
             if (outputs.size() > 1) {
@@ -363,9 +380,12 @@ bool PGSolver::constructMealyMachine(mealy::MealyMachine& m, const bool add_prod
             }
         }
 
+        std::vector<SpecSeq<letter_t>> cubes;
         for (const auto& entry : input_list) {
-            for (BDDtoSpecSeqIterator<letter_t> in_it(entry.second, arena.n_inputs); !in_it.done(); in_it++) {
-                machine[state].push_back( mealy::Transition(entry.first.successor, *in_it, entry.first.output) );
+            cubes.clear();
+            input_cover.cover(entry.second, cubes);
+            for (const SpecSeq<letter_t>& cube : cubes) {
+                machine[state].push_back( mealy::Transition(entry.first.successor, cube, entry.first.output) );
             }
         }
     }
@@ -0,0 +1,146 @@
+#include "StateStore.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <boost/functional/hash.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+
+namespace pg {
+
+constexpr size_t INITIAL_CAPACITY = 4096;
+
+StateStore::StateStore(const size_t width, const bool file_backed) :
+    width(width),
+    file_backed(file_backed),
+    n_states(0),
+    capacity(0),
+    data(nullptr),
+    fd(-1),
+    mapped_bytes(0),
+    spilled_end(0),
+    bytes_spilled(0)
+{
+    if (file_backed) {
+        boost::filesystem::path tmpfile_template_path = boost::filesystem::temp_directory_path() / "strix-states.XXXXXX";
+        std::string tmp_filename = tmpfile_template_path.string();
+        fd = mkstemp(&tmp_filename[0]);
+        if (fd == -1) {
+            throw std::runtime_error("Could not create temporary file: " + tmp_filename);
+        }
+        // only keep the file descriptor, file is removed when it is closed
+        unlink(tmp_filename.c_str());
+    }
+}
+
+StateStore::~StateStore() {
+    if (file_backed) {
+        if (data != nullptr) {
+            munmap(data, mapped_bytes);
+        }
+        close(fd);
+    }
+}
+
+void StateStore::grow() {
+    const size_t new_capacity = std::max(2 * capacity, INITIAL_CAPACITY);
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    size_t new_bytes = new_capacity * width * sizeof(node_id_t);
+    new_bytes = std::max(page_size, ((new_bytes + page_size - 1) / page_size) * page_size);
+
+    if (ftruncate(fd, new_bytes) != 0) {
+        throw std::runtime_error("Could not resize temporary file for product states");
+    }
+    if (data != nullptr) {
+        munmap(data, mapped_bytes);
+    }
+    void* mapping = mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Could not map temporary file for product states");
+    }
+    data = static_cast<node_id_t*>(mapping);
+    mapped_bytes = new_bytes;
+    capacity = mapped_bytes / std::max<size_t>(1, width * sizeof(node_id_t));
+}
+
+node_id_t StateStore::push_back(const product_state_t& state) {
+    assert(state.size() == width);
+    if (file_backed) {
+        if (n_states == capacity) {
+            grow();
+        }
+        std::copy(state.cbegin(), state.cend(), data + n_states * width);
+    }
+    else {
+        memory.insert(memory.end(), state.cbegin(), state.cend());
+        data = memory.data();
+    }
+    return n_states++;
+}
+
+void StateStore::pop_back() {
+    n_states--;
+    if (!file_backed) {
+        memory.resize(n_states * width);
+    }
+}
+
+product_state_t StateStore::get(const node_id_t ref_id) const {
+    const node_id_t* state = (*this)[ref_id];
+    return product_state_t(state, state + width);
+}
+
+size_t StateStore::hash(const node_id_t ref_id) const {
+    const node_id_t* state = (*this)[ref_id];
+    return boost::hash_range(state, state + width);
+}
+
+bool StateStore::equal(const node_id_t ref_id_1, const node_id_t ref_id_2) const {
+    return std::equal((*this)[ref_id_1], (*this)[ref_id_1] + width, (*this)[ref_id_2]);
+}
+
+size_t StateStore::spill(const node_id_t cold_end) {
+    if (!file_backed || data == nullptr) {
+        return 0;
+    }
+
+    // only whole pages of cold states, so that the hot tail is not touched
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    const size_t cold_bytes = std::min((size_t)cold_end * width * sizeof(node_id_t), mapped_bytes);
+    const size_t end = (cold_bytes / page_size) * page_size;
+    if (end <= spilled_end) {
+        return 0;
+    }
+    char* const begin_address = reinterpret_cast<char*>(data) + spilled_end;
+    const size_t length = end - spilled_end;
+
+    // count resident pages before releasing them
+    std::vector<unsigned char> resident(length / page_size);
+    size_t released = 0;
+    if (mincore(begin_address, length, resident.data()) == 0) {
+        for (const unsigned char page : resident) {
+            if (page & 1) {
+                released += page_size;
+            }
+        }
+    }
+
+    if (msync(begin_address, length, MS_SYNC) != 0) {
+        throw std::runtime_error("Could not write product states to temporary file");
+    }
+    madvise(begin_address, length, MADV_DONTNEED);
+
+    spilled_end = end;
+    bytes_spilled += released;
+    return released;
+}
+
+}
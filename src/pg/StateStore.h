@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+
+#include "Definitions.h"
+
+namespace pg {
+
+/*
+ * Flat storage of the fixed-width product states of the arena, indexed by
+ * reference id.
+ *
+ * If file backed, the states are kept in a memory-mapped temporary file,
+ * and spill() writes the pages of a cold prefix of the states back to the
+ * file and releases them, so that they only occupy memory again when
+ * accessed. Each page is released at most once, so repeated calls only
+ * process the part of the prefix that became cold since the last call.
+ */
+class StateStore {
+private:
+    const size_t width;
+    const bool file_backed;
+
+    size_t n_states;
+    size_t capacity;
+    node_id_t* data;
+
+    std::vector<node_id_t> memory;
+    int fd;
+    size_t mapped_bytes;
+    // end of the released prefix of the file in bytes
+    size_t spilled_end;
+    size_t bytes_spilled;
+
+    void grow();
+
+public:
+    StateStore(const size_t width, const bool file_backed);
+    ~StateStore();
+
+    StateStore(const StateStore&) = delete;
+    StateStore& operator=(const StateStore&) = delete;
+
+    inline size_t size() const { return n_states; }
+    inline size_t getBytesSpilled() const { return bytes_spilled; }
+
+    inline const node_id_t* operator[](const node_id_t ref_id) const {
+        return data + (size_t)ref_id * width;
+    }
+
+    // append a state and return its reference id
+    node_id_t push_back(const product_state_t& state);
+    void pop_back();
+
+    product_state_t get(const node_id_t ref_id) const;
+
+    size_t hash(const node_id_t ref_id) const;
+    bool equal(const node_id_t ref_id_1, const node_id_t ref_id_2) const;
+
+    // release the resident pages of a file-backed store that only contain states
+    // with reference ids below cold_end, returns the number of bytes released
+    size_t spill(const node_id_t cold_end);
+};
+
+}
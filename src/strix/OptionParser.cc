@@ -3,14 +3,27 @@
 #include <iostream>
 #include <boost/algorithm/string/predicate.hpp>
 
+// budget for the exact minimization with --auto, unless given explicitly
+constexpr double AUTO_MINIMIZE_TIMEOUT = 60;
+constexpr int AUTO_MINIMIZE_MEMORY_MB = 4096;
+
 std::ostream& operator<<(std::ostream& out, const ExplorationStrategy& exploration) {
     switch (exploration) {
         case ExplorationStrategy::BFS:
             out << "bfs";
             break;
+        case ExplorationStrategy::DFS:
+            out << "dfs";
+            break;
         case ExplorationStrategy::PQ:
             out << "pq";
             break;
+        case ExplorationStrategy::BEAM:
+            out << "beam";
+            break;
+        case ExplorationStrategy::COLOR:
+            out << "color";
+            break;
     }
     return out;
 }
@@ -21,9 +34,45 @@ std::istream& operator>>(std::istream& in, ExplorationStrategy& exploration) {
     if (token == "bfs") {
         exploration = ExplorationStrategy::BFS;
     }
+    else if (token == "dfs") {
+        exploration = ExplorationStrategy::DFS;
+    }
     else if (token == "pq") {
         exploration = ExplorationStrategy::PQ;
     }
+    else if (token == "beam") {
+        exploration = ExplorationStrategy::BEAM;
+    }
+    else if (token == "color") {
+        exploration = ExplorationStrategy::COLOR;
+    }
+    else {
+        in.setstate(std::ios_base::failbit);
+    }
+    return in;
+}
+
+std::ostream& operator<<(std::ostream& out, const MinimizationSearch& search) {
+    switch (search) {
+        case MinimizationSearch::LINEAR:
+            out << "linear";
+            break;
+        case MinimizationSearch::GALLOPING:
+            out << "galloping";
+            break;
+    }
+    return out;
+}
+
+std::istream& operator>>(std::istream& in, MinimizationSearch& search) {
+    std::string token;
+    in >> token;
+    if (token == "linear") {
+        search = MinimizationSearch::LINEAR;
+    }
+    else if (token == "galloping") {
+        search = MinimizationSearch::GALLOPING;
+    }
     else {
         in.setstate(std::ios_base::failbit);
     }
@@ -63,6 +112,7 @@ OptionParser::OptionParser(const int argc, const char* argv[]) :
         ("formula,f", po::value<std::string>()->default_value(std::string()), "use the LTL formula given by arg instead of FILE")
         ("ins", po::value<std::string>(), "use this comma-separated list of input propositions")
         ("outs", po::value<std::string>(), "use this comma-separated list of output propositions")
+        ("load-game", po::value<std::string>()->default_value(""), "solve the parity game in binary format from this file instead of an LTL specification")
     ;
     output_options.add_options()
         ("kiss,k", "output Mealy machine in KISS format")
@@ -71,13 +121,15 @@ OptionParser::OptionParser(const int argc, const char* argv[]) :
         ("bdd,b", "output BDDs in DOT format")
         ("parity-game,p", "output parity game in PGSolver format")
         ("output,o", po::value<std::string>()->default_value(""), "output controller to this file")
+        ("save-game", po::value<std::string>()->default_value(""), "save parity game in binary format to this file")
+        ("stats-json", po::value<std::string>()->default_value(""), "write statistics in JSON format to this file")
     ;
     synthesis_options.add_options()
         ("realizability,r", "only check realizability")
         ("labels,l", "use product state labels for Mealy machine")
         ("minimize,m", "minimize Mealy machine")
         ("auto,a", "automatically find configuration producing minimal AIGER circuit")
-        ("exploration,e", po::value<ExplorationStrategy>()->default_value(ExplorationStrategy::BFS), "exploration strategy (bfs or pq)")
+        ("exploration,e", po::value<ExplorationStrategy>()->default_value(ExplorationStrategy::BFS), "exploration strategy (bfs, dfs, pq, beam or color)")
         ("clear-queue,c", "regularly clear exploration queue from unreachable and already winning states")
         ("from-ltlf", po::value<std::string>()->default_value("")->implicit_value("alive"), "transform LTLf (finite LTL) to LTL by introducing some 'alive' proposition")
     ;
@@ -86,8 +138,16 @@ OptionParser::OptionParser(const int argc, const char* argv[]) :
         ("no-onthefly", "do not construct and solve arena on-the-fly")
         ("no-simplify-formula", "do not simplify the formula")
         ("threads", po::value<int>()->default_value(0, "auto"), "set the number of solver threads")
+        ("beam-width", po::value<int>()->default_value(64), "number of states explored per layer for beam exploration")
+        ("max-memory", po::value<int>()->default_value(0, "unbounded"), "memory limit in MB above which product states of the arena are spilled to disk (edge labels are dropped with -r)")
         ("no-compact-colors", "do not compact the colors of the parity game")
         ("no-compress-circuit", "do not compress the AIGER circuit using ABC")
+        ("parallel-compression", "compress the AIGER circuits for different configurations concurrently in separate processes")
+        ("compression-timeout", po::value<double>()->default_value(300), "time limit in seconds for parallel compression, after which circuits are used uncompressed (has to be positive, as a forked process may deadlock)")
+        ("reordering-timeout", po::value<double>()->default_value(0, "unbounded"), "time limit in seconds for reordering the BDDs of each AIGER circuit")
+        ("minimize-search", po::value<MinimizationSearch>()->default_value(MinimizationSearch::LINEAR), "search for the number of states of the minimized Mealy machine (linear or galloping)")
+        ("minimize-timeout", po::value<double>()->default_value(0, "unbounded"), "time limit in seconds for the exact minimization of the Mealy machine, after which the smallest machine found so far is used (60 with --auto)")
+        ("minimize-memory", po::value<int>()->default_value(0, "unbounded"), "limit in MB for the growth of the resident memory of the process during the exact minimization of the Mealy machine, after which the smallest machine found so far is used (4096 with --auto)")
         ("validate-jni", "validate JNI interface")
         ("optimize-heap", "optimize Java heap size")
         ("max-heap-size", po::value<int>()->default_value(0, "auto"), "maximum heap size in GB")
@@ -150,6 +210,7 @@ Options OptionParser::parse_options() const {
         options.input_files = vm["input-file"].as<std::vector<std::string>>();
     }
     options.formula = vm["formula"].as<std::string>();
+    options.load_game = vm["load-game"].as<std::string>();
     const auto is_sep = boost::is_any_of(",; \t\r\n");
     if (vm.count("ins") > 0) {
         std::string inputs_string = vm["ins"].as<std::string>();
@@ -168,6 +229,8 @@ Options OptionParser::parse_options() const {
 
     // output options
     options.output_file = vm["output"].as<std::string>();
+    options.save_game = vm["save-game"].as<std::string>();
+    options.stats_json = vm["stats-json"].as<std::string>();
     options.mealy = vm.count("kiss") > 0;
     options.binary = vm.count("binary") > 0;
     options.dot = vm.count("dot") > 0;
@@ -196,8 +259,40 @@ Options OptionParser::parse_options() const {
     if (options.threads < 0) {
         throw std::invalid_argument("Invalid number of threads: " + std::to_string(options.threads));
     }
+    options.beam_width = vm["beam-width"].as<int>();
+    if (options.beam_width <= 0) {
+        throw std::invalid_argument("Invalid beam width: " + std::to_string(options.beam_width));
+    }
+    options.max_memory_mb = vm["max-memory"].as<int>();
+    if (options.max_memory_mb < 0) {
+        throw std::invalid_argument("Invalid memory limit: " + std::to_string(options.max_memory_mb));
+    }
     options.compact_colors = vm.count("no-compact-colors") == 0;
     options.compress_circuit = vm.count("no-compress-circuit") == 0;
+    options.parallel_compression = vm.count("parallel-compression") > 0;
+    options.compression_timeout = vm["compression-timeout"].as<double>();
+    if (options.compression_timeout <= 0) {
+        throw std::invalid_argument("Invalid compression time limit: " + std::to_string(options.compression_timeout));
+    }
+    options.reordering_timeout = vm["reordering-timeout"].as<double>();
+    if (options.reordering_timeout < 0) {
+        throw std::invalid_argument("Invalid reordering time limit: " + std::to_string(options.reordering_timeout));
+    }
+    options.minimize_search = vm["minimize-search"].as<MinimizationSearch>();
+    options.minimize_timeout = vm["minimize-timeout"].as<double>();
+    if (options.auto_aiger && vm["minimize-timeout"].defaulted()) {
+        options.minimize_timeout = AUTO_MINIMIZE_TIMEOUT;
+    }
+    if (options.minimize_timeout < 0) {
+        throw std::invalid_argument("Invalid minimization time limit: " + std::to_string(options.minimize_timeout));
+    }
+    options.minimize_memory_mb = vm["minimize-memory"].as<int>();
+    if (options.auto_aiger && vm["minimize-memory"].defaulted()) {
+        options.minimize_memory_mb = AUTO_MINIMIZE_MEMORY_MB;
+    }
+    if (options.minimize_memory_mb < 0) {
+        throw std::invalid_argument("Invalid minimization memory limit: " + std::to_string(options.minimize_memory_mb));
+    }
     options.validate_jni = vm.count("validate-jni") > 0;
     options.aggressive_heap_optimizations = vm.count("optimize-heap") > 0;
     options.max_heap_size_gb = vm["max-heap-size"].as<int>();
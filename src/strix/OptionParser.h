@@ -19,9 +19,12 @@ struct Options {
     std::string formula;
     std::vector<std::string> inputs;
     std::vector<std::string> outputs;
+    std::string load_game;
 
     // output options
     std::string output_file;
+    std::string save_game;
+    std::string stats_json;
     bool mealy;
     bool binary;
     bool dot;
@@ -42,8 +45,16 @@ struct Options {
     bool onthefly;
     bool simplify_formula;
     int threads;
+    int beam_width;
+    int max_memory_mb;
     bool compact_colors;
     bool compress_circuit;
+    bool parallel_compression;
+    double compression_timeout;
+    double reordering_timeout;
+    MinimizationSearch minimize_search;
+    double minimize_timeout;
+    int minimize_memory_mb;
     bool validate_jni;
     bool aggressive_heap_optimizations;
     int max_heap_size_gb;
@@ -9,6 +9,7 @@
 #include "OptionParser.h"
 #include "Definitions.h"
 #include "util/Timer.h"
+#include "util/Statistics.h"
 #include "ltl/LTLParser.h"
 #include "ltl/Specification.h"
 #include "mealy/MealyMachine.h"
@@ -30,6 +31,58 @@ std::string construct_classpath(const strix::Options& options) {
     }
 }
 
+void print_winner(const Player winner) {
+    switch (winner) {
+        case SYS_PLAYER:
+            std::cout << "REALIZABLE" << std::endl;
+            break;
+        case ENV_PLAYER:
+            std::cout << "UNREALIZABLE" << std::endl;
+            break;
+        case UNKNOWN:
+            std::cout << "UNKNOWN" << std::endl;
+            break;
+    }
+}
+
+std::unique_ptr<mealy::MealyMachine> construct_machine(const strix::Options& options, std::ostream& out, pg::PGArena& arena, pg::PGSolver& solver, const Player winner, const std::vector<std::string>& inputs, const std::vector<std::string>& outputs, const bool product_labels) {
+    Timer timer(options.timing);
+
+    if (options.verbosity >= 1) {
+        arena.print_basic_info();
+    }
+    if (options.parity_game) {
+        timer.start("writing parity game");
+        arena.print(out, winner);
+        timer.stop();
+    }
+    if (!options.save_game.empty()) {
+        timer.start("saving parity game");
+        arena.writeGame(options.save_game, inputs, outputs);
+        timer.stop();
+    }
+
+    std::unique_ptr<mealy::MealyMachine> m;
+    if (winner != UNKNOWN && !options.realizability) {
+        if (winner == SYS_PLAYER) {
+            timer.start("constructing Mealy machine");
+            m = std::unique_ptr<mealy::MealyMachine>(new mealy::MealyMachine(inputs, outputs, mealy::Semantic::MEALY));
+            solver.constructMealyMachine(*m, product_labels);
+            timer.stop();
+        }
+        else if (winner == ENV_PLAYER) {
+            timer.start("constructing Moore machine");
+            m = std::unique_ptr<mealy::MealyMachine>(new mealy::MealyMachine(outputs, inputs, mealy::Semantic::MOORE));
+            solver.constructMooreMachine(*m, product_labels);
+            timer.stop();
+        }
+        if (options.labels && !m->hasLabels() && options.verbosity >= 1) {
+            std::cerr << "Error: cannot construct product labels" << std::endl;
+        }
+    }
+    return m;
+}
+
 std::unique_ptr<mealy::MealyMachine> check_realizability(const strix::Options& options, std::ostream& out, owl::OwlThread& owl, const ltl::Specification& spec) {
     Timer realizability_timer(options.timing);
     Timer timer(options.timing);
@@ -44,15 +97,18 @@ std::unique_ptr<mealy::MealyMachine> check_realizability(const strix::Options& o
     const int firstOutputVariable = spec.inputs.size();
     owl::DecomposedDPA automaton = owl.createAutomaton(spec.formula, options.simplify_formula, options.monolithic, firstOutputVariable);
     aut::AutomatonTreeStructure structure(std::move(automaton));
-    pg::PGArena arena(spec.inputs.size(), spec.outputs.size(), structure, options.exploration, options.clear_queue);
+    pg::PGArena arena(spec.inputs.size(), spec.outputs.size(), structure, options.exploration, options.clear_queue, options.beam_width, (size_t)options.max_memory_mb << 20);
     timer.stop();
 
+    // product states are only needed afterwards for labelling the machine
+    const bool product_labels = !options.realizability && options.labels;
+
     if (options.onthefly) {
         timer.start("solving game in parallel with construction of arena");
     }
     else {
         timer.start("constructing arena");
-        arena.constructArena(false, options.realizability, options.verbosity);
+        arena.constructArena(false, options.realizability, product_labels, options.verbosity);
         timer.stop();
         timer.start("solving game");
     }
@@ -60,7 +116,7 @@ std::unique_ptr<mealy::MealyMachine> check_realizability(const strix::Options& o
     pg::PGSISolver solver(arena, options.onthefly, options.threads, options.compact_colors, options.verbosity);
     if (options.onthefly) {
         std::thread solver_thread = std::thread(&pg::PGSolver::solve, &solver);
-        arena.constructArena(true, options.realizability, options.verbosity);
+        arena.constructArena(true, options.realizability, product_labels, options.verbosity);
         solver_thread.join();
     }
     else {
@@ -69,48 +125,38 @@ std::unique_ptr<mealy::MealyMachine> check_realizability(const strix::Options& o
     timer.stop();
 
     Player winner = solver.getWinner();
-    switch (winner) {
-        case SYS_PLAYER:
-            std::cout << "REALIZABLE" << std::endl;
-            break;
-        case ENV_PLAYER:
-            std::cout << "UNREALIZABLE" << std::endl;
-            break;
-        case UNKNOWN:
-            std::cout << "UNKNOWN" << std::endl;
-            break;
-    }
+    print_winner(winner);
     realizability_timer.stop();
 
-    if (options.verbosity >= 1) {
-        arena.print_basic_info();
-    }
-    if (options.parity_game) {
-        timer.start("writing parity game");
-        arena.print(out, winner);
-        timer.stop();
-    }
+    return construct_machine(options, out, arena, solver, winner, spec.inputs, spec.outputs, options.labels);
+}
 
-    std::unique_ptr<mealy::MealyMachine> m;
-    if (winner != UNKNOWN && !options.realizability) {
-        bool with_labels = true;
-        if (winner == SYS_PLAYER) {
-            timer.start("constructing Mealy machine");
-            m = std::unique_ptr<mealy::MealyMachine>(new mealy::MealyMachine(spec.inputs, spec.outputs, mealy::Semantic::MEALY));
-            with_labels = solver.constructMealyMachine(*m, options.labels);
-            timer.stop();
-        }
-        else if (winner == ENV_PLAYER) {
-            timer.start("constructing Moore machine");
-            m = std::unique_ptr<mealy::MealyMachine>(new mealy::MealyMachine(spec.outputs, spec.inputs, mealy::Semantic::MOORE));
-            with_labels = solver.constructMooreMachine(*m, options.labels);
-            timer.stop();
-        }
-        if (options.labels && !m->hasLabels() && options.verbosity >= 1) {
-            std::cerr << "Error: cannot construct product labels" << std::endl;
-        }
+std::unique_ptr<mealy::MealyMachine> check_realizability_of_game(const strix::Options& options, std::ostream& out) {
+    Timer realizability_timer(options.timing);
+    Timer timer(options.timing);
+
+    realizability_timer.start("checking realizability");
+
+    timer.start("loading parity game");
+    std::vector<std::string> inputs;
+    std::vector<std::string> outputs;
+    std::unique_ptr<pg::PGArena> arena = pg::PGArena::loadGame(options.load_game, inputs, outputs);
+    timer.stop();
+    if (!options.realizability && !arena->hasLabels()) {
+        throw std::invalid_argument("Parity game has no labels, only realizability can be checked: " + options.load_game);
     }
-    return m;
+
+    timer.start("solving game");
+    pg::PGSISolver solver(*arena, false, options.threads, options.compact_colors, options.verbosity);
+    solver.solve();
+    timer.stop();
+
+    Player winner = solver.getWinner();
+    print_winner(winner);
+    realizability_timer.stop();
+
+    // product states are not stored in the game
+    return construct_machine(options, out, *arena, solver, winner, inputs, outputs, false);
 }
 
 void construct_solution(const strix::Options& options, std::ostream& out, mealy::MealyMachine& m) {
@@ -121,14 +167,22 @@ void construct_solution(const strix::Options& options, std::ostream& out, mealy:
     if (options.verbosity >= 1) {
         std::cout << "Number of states of Mealy machine: " << m.numberOfStates() << std::endl;
     }
-    // in auto mode, do not try to minimize huge Mealy machines
-    bool minimize = options.minimize && (!options.auto_aiger || m.numberOfStates() < 10000);
-    if (minimize) {
+    if (options.minimize) {
         timer.start("minimize Mealy machine");
         if (options.verbosity >= 1) {
             std::cout << "Minimizing Mealy machine" << std::endl;
         }
-        m.minimizeMachine(options.verbosity);
+        mealy::MinimizationOptions minimization_options;
+        minimization_options.search = options.minimize_search;
+        minimization_options.threads = options.threads;
+        minimization_options.time_limit = std::chrono::duration<double>(options.minimize_timeout);
+        minimization_options.max_memory = (size_t)options.minimize_memory_mb << 20;
+        // in auto mode, do not try to minimize huge Mealy machines exactly, as the
+        // SAT encoding is quadratic in the number of states for each solver thread
+        if (options.auto_aiger) {
+            minimization_options.max_exact_states = 10000;
+        }
+        m.minimizeMachine(minimization_options, options.verbosity);
         if (options.verbosity >= 1) {
             if (m.hasMinimized()) {
                 std::cout << "Number of states of minimized Mealy machine: " << m.numberOfMinStates() << std::endl;
@@ -153,10 +207,14 @@ void construct_solution(const strix::Options& options, std::ostream& out, mealy:
         const bool use_minimized = m.hasMinimized();
         std::shared_ptr<aig::AigerConstructor> aiger;
         if (options.auto_aiger) {
-            aiger = aig::AigerConstructor::findMinimalAiger(m, use_labels, use_minimized, options.compress_circuit, options.bdd);
+            aiger = aig::AigerConstructor::findMinimalAiger(m, use_labels, use_minimized, options.compress_circuit, options.bdd,
+                    options.parallel_compression, std::chrono::duration<double>(options.compression_timeout), options.threads,
+                    std::chrono::duration<double>(options.reordering_timeout));
         }
         else {
-            aiger = std::shared_ptr<aig::AigerConstructor>(new aig::AigerConstructor(m, use_labels, use_minimized));
+            aiger = std::shared_ptr<aig::AigerConstructor>(new aig::AigerConstructor(m, use_labels, use_minimized, options.threads));
+            aiger->setInputOrder(aig::AigerConstructor::computeInputOrder(m));
+            aiger->setReorderingBudget(std::chrono::duration<double>(options.reordering_timeout));
             aiger->construct(options.compress_circuit, options.bdd);
         }
         if (options.bdd) {
@@ -191,6 +249,17 @@ void synthesis(const strix::Options& options) {
     }
     std::ostream out(buf);
 
+    if (!options.load_game.empty()) {
+        // game is already constructed, Owl is not needed
+        std::unique_ptr<mealy::MealyMachine> m = check_realizability_of_game(options, out);
+        if (m) {
+            construct_solution(options, out, *m);
+        }
+        of.close();
+        strix_timer.stop();
+        return;
+    }
+
     timer.start("initializing OWL-JNI");
     const std::string classpath_option = construct_classpath(options);
     owl::OwlJavaVM owlJavaVM(classpath_option.c_str(), options.validate_jni, options.initial_heap_size_gb, options.max_heap_size_gb, options.aggressive_heap_optimizations);
@@ -235,6 +304,9 @@ int main(const int argc, const char* argv[]) {
         }
         else {
             synthesis(options);
+            if (!options.stats_json.empty()) {
+                Statistics::writeJSON(options.stats_json);
+            }
         }
 
     }
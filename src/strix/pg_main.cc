@@ -0,0 +1,106 @@
+#include <iostream>
+#include <string>
+#include <memory>
+
+#include <boost/program_options.hpp>
+
+#include "Definitions.h"
+#include "util/Timer.h"
+#include "util/Statistics.h"
+#include "pg/PGArena.h"
+#include "pg/PGSolver.h"
+#include "pg/PGSISolver.h"
+
+namespace po = boost::program_options;
+
+/*
+ * Solver for parity games in PGSolver format, without constructing them
+ * from a specification. Player 0 wins even priorities.
+ */
+int main(const int argc, const char* argv[]) {
+    try {
+        po::options_description options("Options");
+        options.add_options()
+            ("init", po::value<node_id_t>(), "initial node (default: start node of the game or 0)")
+            ("threads", po::value<int>()->default_value(0, "auto"), "set the number of solver threads")
+            ("no-compact-colors", "do not compact the colors of the parity game")
+            ("verbose,v", po::value<int>()->default_value(0)->implicit_value(1), "verbosity level")
+            ("timing,t", "measure and print timing information")
+            ("stats-json", po::value<std::string>(), "write statistics in JSON format to this file")
+            ("help,h", "display this help text and exit")
+        ;
+        po::options_description hidden_options;
+        hidden_options.add_options()
+            ("input-file", po::value<std::string>(), "input file")
+        ;
+        po::options_description all_options;
+        all_options.add(options).add(hidden_options);
+        po::positional_options_description positional_options;
+        positional_options.add("input-file", 1);
+
+        po::variables_map vm;
+        po::store(po::command_line_parser(argc, argv).
+                options(all_options).
+                positional(positional_options).
+                run(), vm);
+        po::notify(vm);
+
+        if (vm.count("help") > 0) {
+            std::cout << "Usage: strix-pg [OPTIONS...] FILE" << std::endl;
+            std::cout << "Determines the winner of the initial node of a parity game in PGSolver format," << std::endl;
+            std::cout << "which is printed as EVEN for player 0 or ODD for player 1." << std::endl;
+            std::cout << std::endl;
+            std::cout << options << std::endl;
+            return EXIT_SUCCESS;
+        }
+        if (vm.count("input-file") == 0) {
+            throw std::invalid_argument("No input file was given.");
+        }
+        const std::string input_file = vm["input-file"].as<std::string>();
+        const node_id_t initial_id = vm.count("init") > 0 ? vm["init"].as<node_id_t>() : NODE_NONE;
+        const int threads = vm["threads"].as<int>();
+        if (threads < 0) {
+            throw std::invalid_argument("Invalid number of threads: " + std::to_string(threads));
+        }
+        const bool compact_colors = vm.count("no-compact-colors") == 0;
+        const int verbosity = vm["verbose"].as<int>();
+        const bool timing = vm.count("timing") > 0;
+
+        Timer timer(timing);
+
+        timer.start("parsing parity game");
+        std::unique_ptr<pg::PGArena> arena = pg::PGArena::loadPGSolverGame(input_file, initial_id);
+        timer.stop();
+
+        if (verbosity >= 1) {
+            arena->print_basic_info();
+        }
+
+        timer.start("solving game");
+        pg::PGSISolver solver(*arena, false, threads, compact_colors, verbosity);
+        solver.solve();
+        timer.stop();
+
+        switch (solver.getWinner()) {
+            case SYS_PLAYER:
+                std::cout << "EVEN" << std::endl;
+                break;
+            case ENV_PLAYER:
+                std::cout << "ODD" << std::endl;
+                break;
+            case UNKNOWN:
+                std::cout << "UNKNOWN" << std::endl;
+                break;
+        }
+
+        if (vm.count("stats-json") > 0) {
+            Statistics::writeJSON(vm["stats-json"].as<std::string>());
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cuddObj.hh"
+#include <boost/functional/hash.hpp>
+
+#include "SpecSeq.h"
+
+/*
+ * Irredundant sum-of-products covers of BDDs as cubes, computed with the
+ * algorithm of Minato and Morreale.
+ *
+ * Unlike the disjoint cubes of the paths of a BDD, the cubes of the cover
+ * may overlap, but there are usually fewer and larger ones. The covers of
+ * all subproblems and the densities of all nodes are cached in the object,
+ * so one object should be used for all BDDs of a manager that are extracted
+ * together, e.g. for all edges of a game. Cubes of all covers are stored in
+ * one pool, so that the cache does not need an allocation per entry.
+ */
+template <typename I>
+class BDDCover {
+private:
+    typedef std::pair<DdNode*, DdNode*> node_pair_t;
+
+    // cover of a subproblem with its cubes in the pool
+    struct Result {
+        BDD cover;
+        size_t begin;
+        size_t end;
+    };
+    struct CacheEntry {
+        // bounds of the subproblem, kept referenced so that the nodes of the key are not reused
+        BDD lower;
+        BDD upper;
+        Result result;
+    };
+
+    const Cudd& manager;
+    std::vector<SpecSeq<I>> pool;
+    std::unordered_map<node_pair_t, CacheEntry, boost::hash<node_pair_t>> cache;
+    std::unordered_map<DdNode*, std::pair<BDD, double>> densities;
+
+    inline int level(DdNode* node) const {
+        if (Cudd_IsConstant(node)) {
+            return std::numeric_limits<int>::max();
+        }
+        return manager.ReadPerm(Cudd_NodeReadIndex(node));
+    }
+
+    // cofactors of f with respect to the variable with the given index
+    inline void cofactors(const BDD& f, const unsigned int index, BDD& f0, BDD& f1) const {
+        DdNode* const node = f.getNode();
+        DdNode* const regular = Cudd_Regular(node);
+        if (!Cudd_IsConstant(regular) && Cudd_NodeReadIndex(regular) == index) {
+            const int complement = Cudd_IsComplement(node);
+            f0 = BDD(manager, Cudd_NotCond(Cudd_E(regular), complement));
+            f1 = BDD(manager, Cudd_NotCond(Cudd_T(regular), complement));
+        }
+        else {
+            f0 = f;
+            f1 = f;
+        }
+    }
+
+    // appends the cubes in [begin, end) of the pool with the given literal added
+    inline void append_cubes(const size_t begin, const size_t end, const I bit, const bool value) {
+        for (size_t i = begin; i < end; i++) {
+            SpecSeq<I> cube = pool[i];
+            cube.unspecifiedBits &= ~bit;
+            if (value) {
+                cube.number |= bit;
+            }
+            pool.push_back(cube);
+        }
+    }
+
+    // irredundant cover of some function between lower and upper
+    Result isop(const BDD& lower, const BDD& upper) {
+        if (lower.IsZero()) {
+            return Result{ manager.bddZero(), 0, 0 };
+        }
+        if (upper.IsOne()) {
+            // the first cube of the pool is the tautology
+            return Result{ manager.bddOne(), 0, 1 };
+        }
+
+        const node_pair_t key(lower.getNode(), upper.getNode());
+        const auto it = cache.find(key);
+        if (it != cache.end()) {
+            return it->second.result;
+        }
+
+        DdNode* const lower_node = Cudd_Regular(lower.getNode());
+        DdNode* const upper_node = Cudd_Regular(upper.getNode());
+        const unsigned int index = level(lower_node) <= level(upper_node) ? Cudd_NodeReadIndex(lower_node) : Cudd_NodeReadIndex(upper_node);
+
+        BDD lower0, lower1, upper0, upper1;
+        cofactors(lower, index, lower0, lower1);
+        cofactors(upper, index, upper0, upper1);
+
+        // cubes needing the negative or positive literal, then cubes without the variable
+        const Result result0 = isop(lower0 & !upper1, upper0);
+        const Result result1 = isop(lower1 & !upper0, upper1);
+        const BDD lower_rest = (lower0 & !result0.cover) | (lower1 & !result1.cover);
+        const Result result_rest = isop(lower_rest, upper0 & upper1);
+
+        const BDD var = manager.bddVar(index);
+        Result result;
+        result.cover = var.Ite(result1.cover, result0.cover) | result_rest.cover;
+        result.begin = pool.size();
+        const I bit = (I)1 << index;
+        append_cubes(result0.begin, result0.end, bit, false);
+        append_cubes(result1.begin, result1.end, bit, true);
+        append_cubes(result_rest.begin, result_rest.end, 0, false);
+        result.end = pool.size();
+
+        cache.insert({ key, CacheEntry{ lower, upper, result } });
+        return result;
+    }
+
+    double density(DdNode* const node) {
+        DdNode* const regular = Cudd_Regular(node);
+        double d;
+        if (Cudd_IsConstant(regular)) {
+            d = (regular == Cudd_ReadOne(manager.getManager())) ? 1.0 : 0.0;
+        }
+        else {
+            const auto it = densities.find(regular);
+            if (it != densities.end()) {
+                d = it->second.second;
+            }
+            else {
+                d = 0.5 * (density(Cudd_T(regular)) + density(Cudd_E(regular)));
+                densities.insert({ regular, { BDD(manager, regular), d } });
+            }
+        }
+        return Cudd_IsComplement(node) ? 1.0 - d : d;
+    }
+
+public:
+    BDDCover(const Cudd& manager, const int n_bits) :
+        manager(manager)
+    {
+        pool.push_back(true_clause<I>(n_bits));
+    }
+
+    // appends the cubes of an irredundant cover of bdd
+    void cover(const BDD& bdd, std::vector<SpecSeq<I>>& cubes) {
+        const Result result = isop(bdd, bdd);
+        cubes.insert(cubes.end(), pool.begin() + result.begin, pool.begin() + result.end);
+    }
+
+    // fraction of the assignments satisfying bdd, which orders BDDs over
+    // the same variables like their number of minterms
+    inline double density(const BDD& bdd) {
+        return density(bdd.getNode());
+    }
+
+    void clear() {
+        cache.clear();
+        densities.clear();
+        pool.resize(1);
+    }
+};
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <cassert>
+
+/*
+ * Addressable d-ary max-heap of (priority, id) entries, where ids are
+ * small dense integers (e.g. reference ids of product states).
+ *
+ * Each id is contained at most once. The position of each id in the heap
+ * is stored in an index vector, so that priorities can be increased or
+ * decreased in place and single entries can be removed in O(log n).
+ */
+template <typename P, typename Id, unsigned D = 4>
+class IndexedHeap {
+    static_assert(D >= 2, "heap arity must be at least two");
+
+public:
+    struct Entry {
+        P priority;
+        Id id;
+
+        Entry(const P priority, const Id id) : priority(priority), id(id) {}
+    };
+
+private:
+    typedef size_t pos_t;
+    static constexpr pos_t POS_NONE = std::numeric_limits<pos_t>::max();
+
+    std::vector<Entry> heap;
+    std::vector<pos_t> position;
+
+    inline void place(const pos_t i, Entry entry) {
+        position[entry.id] = i;
+        heap[i] = std::move(entry);
+    }
+
+    void sift_up(pos_t i) {
+        Entry entry = std::move(heap[i]);
+        while (i > 0) {
+            const pos_t parent = (i - 1) / D;
+            if (!(heap[parent].priority < entry.priority)) {
+                break;
+            }
+            place(i, std::move(heap[parent]));
+            i = parent;
+        }
+        place(i, std::move(entry));
+    }
+
+    void sift_down(pos_t i) {
+        const pos_t n = heap.size();
+        Entry entry = std::move(heap[i]);
+        while (true) {
+            const pos_t first = D * i + 1;
+            if (first >= n) {
+                break;
+            }
+            const pos_t last = std::min(first + D, n);
+            pos_t max_child = first;
+            for (pos_t c = first + 1; c < last; c++) {
+                if (heap[max_child].priority < heap[c].priority) {
+                    max_child = c;
+                }
+            }
+            if (!(entry.priority < heap[max_child].priority)) {
+                break;
+            }
+            place(i, std::move(heap[max_child]));
+            i = max_child;
+        }
+        place(i, std::move(entry));
+    }
+
+    void remove_at(const pos_t i) {
+        position[heap[i].id] = POS_NONE;
+        const pos_t last = heap.size() - 1;
+        if (i != last) {
+            const P old_priority = heap[i].priority;
+            place(i, std::move(heap[last]));
+            heap.pop_back();
+            if (old_priority < heap[i].priority) {
+                sift_up(i);
+            }
+            else {
+                sift_down(i);
+            }
+        }
+        else {
+            heap.pop_back();
+        }
+    }
+
+    void heapify() {
+        for (pos_t i = 0; i < heap.size(); i++) {
+            position[heap[i].id] = i;
+        }
+        if (heap.size() > 1) {
+            for (pos_t i = (heap.size() - 2) / D + 1; i-- > 0; ) {
+                sift_down(i);
+            }
+        }
+    }
+
+public:
+    IndexedHeap() {}
+
+    inline bool empty() const { return heap.empty(); }
+    inline size_t size() const { return heap.size(); }
+
+    inline void reserve(const size_t n) {
+        heap.reserve(n);
+        position.reserve(n);
+    }
+
+    inline bool contains(const Id id) const {
+        return id < position.size() && position[id] != POS_NONE;
+    }
+
+    inline const P& priority(const Id id) const {
+        assert(contains(id));
+        return heap[position[id]].priority;
+    }
+
+    inline const Entry& top() const {
+        return heap.front();
+    }
+
+    inline void pop() {
+        remove_at(0);
+    }
+
+    // insert the id with the given priority, or change the priority if already contained
+    void update(const Id id, const P priority) {
+        if (id >= position.size()) {
+            position.resize(id + 1, POS_NONE);
+        }
+        pos_t i = position[id];
+        if (i == POS_NONE) {
+            i = heap.size();
+            heap.emplace_back(priority, id);
+            position[id] = i;
+            sift_up(i);
+        }
+        else if (heap[i].priority < priority) {
+            heap[i].priority = priority;
+            sift_up(i);
+        }
+        else if (priority < heap[i].priority) {
+            heap[i].priority = priority;
+            sift_down(i);
+        }
+    }
+
+    // insert the id, or increase its priority if it is already contained with a lower one
+    void increase(const Id id, const P priority) {
+        if (!contains(id) || heap[position[id]].priority < priority) {
+            update(id, priority);
+        }
+    }
+
+    // remove the id if contained, returns true if it was removed
+    bool erase(const Id id) {
+        if (contains(id)) {
+            remove_at(position[id]);
+            return true;
+        }
+        else {
+            return false;
+        }
+    }
+
+    void clear() {
+        for (const Entry& entry : heap) {
+            position[entry.id] = POS_NONE;
+        }
+        heap.clear();
+    }
+
+    /*
+     * Visit all entries in arbitrary order. The function is called as
+     * f(id, priority) with a mutable priority and returns false if the
+     * entry should be removed. The heap is restored in linear time
+     * afterwards, so removing or rescoring k entries never copies the heap.
+     */
+    template <typename F>
+    void filter(F f) {
+        pos_t j = 0;
+        for (pos_t i = 0; i < heap.size(); i++) {
+            Entry& entry = heap[i];
+            if (f(entry.id, entry.priority)) {
+                if (i != j) {
+                    heap[j] = std::move(entry);
+                }
+                j++;
+            }
+            else {
+                position[entry.id] = POS_NONE;
+            }
+        }
+        heap.erase(heap.begin() + j, heap.end());
+        heapify();
+    }
+};
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+
+#include <boost/functional/hash.hpp>
+
+/*
+ * Letters over more than 64 signals.
+ *
+ * WideLetter<W> is a bit vector of W words of 64 bits with the operators of
+ * an unsigned integer, so that it can be used in place of uint64_t as type of
+ * the letters and masks in SpecSeq, the arena and the automata. The number of
+ * words is fixed at compile time (CMake option MAX_SIGNALS), and letter_type<1>
+ * is plain uint64_t, so that the common case keeps the single-word code.
+ */
+template <size_t W>
+class WideLetter {
+    static_assert(W > 1, "single-word letters should use uint64_t");
+
+private:
+    static constexpr size_t WORD_BITS = 64;
+
+    // least significant word first
+    std::array<uint64_t, W> words;
+
+public:
+    constexpr WideLetter() : words{} {}
+    constexpr WideLetter(const uint64_t n) : words{ { n } } {}
+
+    static constexpr WideLetter ones() {
+        WideLetter l;
+        for (size_t i = 0; i < W; i++) {
+            l.words[i] = ~(uint64_t)0;
+        }
+        return l;
+    }
+
+    inline uint64_t word(const size_t i) const { return words[i]; }
+    inline void set_word(const size_t i, const uint64_t w) { words[i] = w; }
+    inline bool test(const size_t bit) const {
+        return ((words[bit / WORD_BITS] >> (bit % WORD_BITS)) & 1) != 0;
+    }
+
+    // the lowest word, e.g. for indexing tables over small alphabets
+    explicit inline operator uint64_t() const { return words[0]; }
+
+    inline WideLetter& operator&=(const WideLetter& other) {
+        for (size_t i = 0; i < W; i++) {
+            words[i] &= other.words[i];
+        }
+        return *this;
+    }
+    inline WideLetter& operator|=(const WideLetter& other) {
+        for (size_t i = 0; i < W; i++) {
+            words[i] |= other.words[i];
+        }
+        return *this;
+    }
+    inline WideLetter& operator^=(const WideLetter& other) {
+        for (size_t i = 0; i < W; i++) {
+            words[i] ^= other.words[i];
+        }
+        return *this;
+    }
+    inline WideLetter operator~() const {
+        WideLetter l;
+        for (size_t i = 0; i < W; i++) {
+            l.words[i] = ~words[i];
+        }
+        return l;
+    }
+
+    // shifts by at least the width give zero, unlike for built-in types
+    inline WideLetter& operator<<=(const size_t n) {
+        const size_t word_shift = n / WORD_BITS;
+        const size_t bit_shift = n % WORD_BITS;
+        for (size_t i = W; i-- > 0; ) {
+            uint64_t w = 0;
+            if (i >= word_shift) {
+                w = words[i - word_shift] << bit_shift;
+                if (bit_shift != 0 && i > word_shift) {
+                    w |= words[i - word_shift - 1] >> (WORD_BITS - bit_shift);
+                }
+            }
+            words[i] = w;
+        }
+        return *this;
+    }
+    inline WideLetter& operator>>=(const size_t n) {
+        const size_t word_shift = n / WORD_BITS;
+        const size_t bit_shift = n % WORD_BITS;
+        for (size_t i = 0; i < W; i++) {
+            uint64_t w = 0;
+            if (i + word_shift < W) {
+                w = words[i + word_shift] >> bit_shift;
+                if (bit_shift != 0 && i + word_shift + 1 < W) {
+                    w |= words[i + word_shift + 1] << (WORD_BITS - bit_shift);
+                }
+            }
+            words[i] = w;
+        }
+        return *this;
+    }
+
+    inline WideLetter& operator+=(const WideLetter& other) {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < W; i++) {
+            const uint64_t sum = words[i] + other.words[i];
+            const uint64_t carry_out = sum < words[i];
+            words[i] = sum + carry;
+            carry = carry_out | (words[i] < sum);
+        }
+        return *this;
+    }
+    inline WideLetter& operator-=(const WideLetter& other) {
+        uint64_t borrow = 0;
+        for (size_t i = 0; i < W; i++) {
+            const uint64_t diff = words[i] - other.words[i];
+            const uint64_t borrow_out = words[i] < other.words[i];
+            words[i] = diff - borrow;
+            borrow = borrow_out | (diff < borrow);
+        }
+        return *this;
+    }
+    inline WideLetter& operator++() {
+        for (size_t i = 0; i < W && ++words[i] == 0; i++);
+        return *this;
+    }
+    inline WideLetter operator++(int) {
+        WideLetter l(*this);
+        operator++();
+        return l;
+    }
+
+    friend inline WideLetter operator&(WideLetter a, const WideLetter& b) { return a &= b; }
+    friend inline WideLetter operator|(WideLetter a, const WideLetter& b) { return a |= b; }
+    friend inline WideLetter operator^(WideLetter a, const WideLetter& b) { return a ^= b; }
+    friend inline WideLetter operator<<(WideLetter a, const size_t n) { return a <<= n; }
+    friend inline WideLetter operator>>(WideLetter a, const size_t n) { return a >>= n; }
+    friend inline WideLetter operator+(WideLetter a, const WideLetter& b) { return a += b; }
+    friend inline WideLetter operator-(WideLetter a, const WideLetter& b) { return a -= b; }
+
+    friend inline bool operator==(const WideLetter& a, const WideLetter& b) { return a.words == b.words; }
+    friend inline bool operator!=(const WideLetter& a, const WideLetter& b) { return a.words != b.words; }
+    friend inline bool operator<(const WideLetter& a, const WideLetter& b) {
+        for (size_t i = W; i-- > 0; ) {
+            if (a.words[i] != b.words[i]) {
+                return a.words[i] < b.words[i];
+            }
+        }
+        return false;
+    }
+    friend inline bool operator>(const WideLetter& a, const WideLetter& b) { return b < a; }
+    friend inline bool operator<=(const WideLetter& a, const WideLetter& b) { return !(b < a); }
+    friend inline bool operator>=(const WideLetter& a, const WideLetter& b) { return !(a < b); }
+
+    friend inline size_t hash_value(const WideLetter& l) {
+        size_t seed = 0;
+        for (size_t i = 0; i < W; i++) {
+            boost::hash_combine(seed, l.words[i]);
+        }
+        return seed;
+    }
+
+    friend inline unsigned popcount(const WideLetter& l) {
+        unsigned count = 0;
+        for (size_t i = 0; i < W; i++) {
+            count += __builtin_popcountll(l.words[i]);
+        }
+        return count;
+    }
+
+    // decimal if the value fits into one word, otherwise hexadecimal
+    friend std::ostream& operator<<(std::ostream& out, const WideLetter& l) {
+        size_t top = W - 1;
+        while (top > 0 && l.words[top] == 0) {
+            top--;
+        }
+        if (top == 0) {
+            return out << l.words[0];
+        }
+        const std::ios_base::fmtflags flags = out.flags();
+        const char fill = out.fill();
+        out << "0x" << std::hex << l.words[top];
+        for (size_t i = top; i-- > 0; ) {
+            out << std::setw(16) << std::setfill('0') << l.words[i];
+        }
+        out.flags(flags);
+        out.fill(fill);
+        return out;
+    }
+};
+
+template <size_t W>
+class std::numeric_limits<WideLetter<W>> {
+public:
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = false;
+    static constexpr bool is_integer = true;
+    static constexpr bool is_exact = true;
+    static constexpr int radix = 2;
+    static constexpr int digits = 64 * W;
+    static constexpr WideLetter<W> min() { return WideLetter<W>(); }
+    static constexpr WideLetter<W> max() { return WideLetter<W>::ones(); }
+};
+
+template <size_t W>
+struct std::hash<WideLetter<W>> {
+    std::size_t operator()(const WideLetter<W>& l) const {
+        return hash_value(l);
+    }
+};
+
+template <size_t W>
+struct letter_type {
+    typedef WideLetter<W> type;
+};
+template <>
+struct letter_type<1> {
+    typedef uint64_t type;
+};
+
+// bit i of a letter, for both single-word and multi-word letters
+inline bool test_letter_bit(const uint64_t letter, const size_t i) {
+    return ((letter >> i) & 1) != 0;
+}
+template <size_t W>
+inline bool test_letter_bit(const WideLetter<W>& letter, const size_t i) {
+    return letter.test(i);
+}
+
+// word i of a letter, where single-word letters only have word 0
+inline uint64_t letter_word(const uint64_t letter, const size_t i) {
+    return i == 0 ? letter : 0;
+}
+template <size_t W>
+inline uint64_t letter_word(const WideLetter<W>& letter, const size_t i) {
+    return i < W ? letter.word(i) : 0;
+}
+inline void set_letter_word(uint64_t& letter, const size_t i, const uint64_t w) {
+    if (i == 0) {
+        letter = w;
+    }
+}
+template <size_t W>
+inline void set_letter_word(WideLetter<W>& letter, const size_t i, const uint64_t w) {
+    if (i < W) {
+        letter.set_word(i, w);
+    }
+}
+
+// mask of the lowest n bits, which also works for n equal to the width
+template <typename I>
+inline I low_bits_mask(const size_t n) {
+    if (n >= (size_t)std::numeric_limits<I>::digits) {
+        return ~(I)0;
+    }
+    return ((I)1 << n) - (I)1;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+
+#include <unistd.h>
+
+// resident set size of the current process in bytes, or 0 if it cannot be determined
+inline size_t resident_memory() {
+    std::ifstream statm("/proc/self/statm");
+    size_t total_pages = 0;
+    size_t resident_pages = 0;
+    if (statm >> total_pages >> resident_pages) {
+        return resident_pages * (size_t)sysconf(_SC_PAGESIZE);
+    }
+    else {
+        return 0;
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+/*
+ * Named zones around pipeline stages for external profilers.
+ *
+ * PROFILE_ZONE("name") marks the rest of the enclosing scope as a zone.
+ * The backend is chosen with the CMake option PROFILER:
+ *  - usdt: user-space probes strix:zone_begin and strix:zone_end with the
+ *    zone name as argument, e.g. for perf after `perf buildid-cache --add`
+ *  - itt: tasks in the domain "strix" for VTune and other ITT consumers
+ *  - none (default): zones are compiled out completely
+ */
+
+#if defined(STRIX_PROFILER_USDT)
+
+#include <sys/sdt.h>
+
+namespace profiler {
+
+class Zone {
+private:
+    const char* const name;
+
+public:
+    Zone(const char* name) : name(name) {
+        DTRACE_PROBE1(strix, zone_begin, name);
+    }
+    ~Zone() {
+        DTRACE_PROBE1(strix, zone_end, name);
+    }
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+};
+
+}
+
+#elif defined(STRIX_PROFILER_ITT)
+
+#include <ittnotify.h>
+
+namespace profiler {
+
+inline __itt_domain* domain() {
+    static __itt_domain* const strix_domain = __itt_domain_create("strix");
+    return strix_domain;
+}
+
+class Zone {
+public:
+    Zone(const char* name) {
+        // string handles are interned by ITT, so repeated creation is cheap
+        __itt_task_begin(domain(), __itt_null, __itt_null, __itt_string_handle_create(name));
+    }
+    ~Zone() {
+        __itt_task_end(domain());
+    }
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+};
+
+}
+
+#endif
+
+#if defined(STRIX_PROFILER_USDT) || defined(STRIX_PROFILER_ITT)
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+#define PROFILE_ZONE(name) const profiler::Zone PROFILE_CONCAT(profile_zone_, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name) do { } while (false)
+#endif
@@ -1,148 +1,279 @@
 #pragma once
 
-#include <iostream>
+#include <algorithm>
+#include <cstddef>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
 #include <vector>
-#include <string>
-#include <unordered_map>
-#include <cassert>
 
 #include "SpecSeq.h"
 
 /*
- * Table of minterms and implicants
- * first dimension: number of unspecified bits
- * second dimension: number of ones
- * third dimension: value of unspecified bits
- * fourth dimension: value of number
+ * Prime implicants by the method of Quine and McCluskey.
  *
- * To combine terms:
- * - number of unspecified bits has to be equal
- * - number of ones have to differ by exactly one
- * - value of unspecified bits has to be equal
- * - combine function has to return true
+ * The implicants with the same number of unspecified bits are kept in one flat
+ * array, sorted by unspecified bits, number of ones and number, so that each
+ * group of implicants with equal unspecified bits and number of ones is a
+ * contiguous range. Terms can only be combined if
+ * - the values of the unspecified bits are equal,
+ * - the numbers of ones differ by exactly one, and
+ * - the numbers differ in exactly one bit,
+ * so the partners of an implicant are found by binary search in the next group.
+ * The groups of one pass only write to their own entries and are merged in
+ * parallel with OpenMP for large tables.
  */
 template<typename I>
-struct quine_table {
-    size_t size;
-    std::vector< std::vector< std::unordered_map< I, std::unordered_map< I, bool > > > > cells;
-};
+class QuineTable {
+private:
+    struct Implicant {
+        I unspecifiedBits;
+        unsigned ones;
+        I number;
 
-// print the table
-template<typename I>
-void print_table(const quine_table<I>& table) {
-    for (size_t s = 0; s < table.size; s++) {
-        std::cout<<"\n-------------------------------------"<<std::endl;
-        std::cout << "Size " << s << ":" << std::endl;
-        for (size_t i = 0; i < table.cells[s].size(); i++) {
-            if (table.cells[s][i].size() > 0) {
-                std::cout << i;
-            }
-            for (const auto& esum_entry : table.cells[s][i]) {
-                for (const auto& entry : esum_entry.second) {
-                    std::cout << "\t\t" << entry.first << "(" << esum_entry.first << ")";
-                    if (entry.second) {
-                        std::cout << "*";
-                    }
-                    else {
-                        std::cout << " ";
-                    }
-                    std::cout << std::endl;
+        inline bool operator<(const Implicant& other) const {
+            return std::tie(unspecifiedBits, ones, number) < std::tie(other.unspecifiedBits, other.ones, other.number);
+        }
+        inline bool operator==(const Implicant& other) const {
+            return unspecifiedBits == other.unspecifiedBits && number == other.number;
+        }
+    };
+
+    // minimum number of implicants in a pass for merging in parallel
+    static constexpr size_t PARALLEL_THRESHOLD = 4096;
+
+    // single bits of the variables
+    std::vector<I> bits;
+    // implicants by number of unspecified bits
+    std::vector<std::vector<Implicant>> levels;
+    // implicants of the current pass and the start of their groups
+    std::vector<Implicant> current;
+    std::vector<size_t> group_begin;
+    std::vector<unsigned char> combined;
+
+    inline bool same_group(const size_t i, const size_t j) const {
+        return current[i].unspecifiedBits == current[j].unspecifiedBits && current[i].ones == current[j].ones;
+    }
+
+    // combines the implicants of group g with the ones of the next group, where
+    // only the implicants of group g are marked and the indices of their partners
+    // in the next group are returned, so that groups do not write to each other
+    void merge_group(const size_t g, std::vector<Implicant>& next, std::vector<size_t>& partners) {
+        const size_t end = group_begin[g + 1];
+        if (g + 2 >= group_begin.size()) {
+            return;
+        }
+        const I unspecified = current[end - 1].unspecifiedBits;
+        const unsigned ones = current[end - 1].ones;
+        if (current[end].unspecifiedBits != unspecified || current[end].ones != ones + 1) {
+            return;
+        }
+        const auto upper_begin = current.begin() + end;
+        const auto upper_end = current.begin() + group_begin[g + 2];
+
+        for (size_t i = group_begin[g]; i < end; i++) {
+            const I number = current[i].number;
+            // the numbers with an added bit increase with the bit, so the search continues from the last one
+            auto it = upper_begin;
+            for (const I& bit : bits) {
+                if ((unspecified & bit) != 0 || (number & bit) != 0) {
+                    continue;
+                }
+                const I partner = number | bit;
+                it = std::lower_bound(it, upper_end, partner,
+                    [](const Implicant& implicant, const I& n) { return implicant.number < n; });
+                if (it == upper_end) {
+                    break;
+                }
+                if (it->number == partner) {
+                    next.push_back({ unspecified | bit, ones, number });
+                    combined[i] = 1;
+                    partners.push_back(it - current.begin());
                 }
             }
         }
-        std::cout<<"\n-------------------------------------"<<std::endl;
     }
-}
 
-template<typename I>
-quine_table<I> compute_quine_table(const int num_bits, const std::vector<SpecSeq<I>>& values) {
-    assert(num_bits > 0);
-    assert(values.size() > 0);
-    std::cout << "Computing Quine table" << std::endl;
-    for (const auto val : values) {
-        std::cout << val.toString(num_bits) << std::endl;
-    }
-    // TODO: make algorithm work with inputs such as {0-, 10, -1} to obtain {--}
-
-    quine_table<I> table;
-    table.size = 1;
-    // resize table according to number of bits
-    table.cells.resize(num_bits + 1);
-    for (size_t size = 0; size < table.cells.size(); size++) {
-        table.cells[size].resize(num_bits + 1);
+public:
+    QuineTable(const int num_bits, const std::vector<SpecSeq<I>>& values) {
+        for (int bit = 0; bit < num_bits; bit++) {
+            bits.push_back((I)1 << bit);
+        }
+        // one more level for the merges of the last one, which are always empty
+        levels.resize(num_bits + 2);
+        for (const SpecSeq<I>& val : values) {
+            const I number = val.number & ~val.unspecifiedBits;
+            levels[popcount(val.unspecifiedBits)].push_back({ val.unspecifiedBits, popcount(number), number });
+        }
     }
 
-    // fill table with input values
-    for (const auto val : values) {
-        const size_t num_dontcares = popcount(val.unspecifiedBits);
-        const size_t num_ones = popcount(val.number);
+    // all prime implicants, ordered by increasing number of unspecified bits
+    std::vector<SpecSeq<I>> prime_implicants() {
+        // TODO: make algorithm work with inputs such as {0-, 10, -1} to obtain {--}
+        std::vector<SpecSeq<I>> primes;
+        std::vector<size_t> partners;
+        for (size_t level = 0; level < levels.size(); level++) {
+            current = std::move(levels[level]);
+            levels[level].clear();
+            if (current.empty()) {
+                continue;
+            }
+            std::sort(current.begin(), current.end());
+            current.erase(std::unique(current.begin(), current.end()), current.end());
 
-        table.cells[num_dontcares][num_ones][val.unspecifiedBits].insert({ val.number, true });
-        table.size = std::max(table.size, num_dontcares + 1);
-    }
+            group_begin.clear();
+            for (size_t i = 0; i < current.size(); i++) {
+                if (i == 0 || !same_group(i - 1, i)) {
+                    group_begin.push_back(i);
+                }
+            }
+            group_begin.push_back(current.size());
+            const size_t n_groups = group_begin.size() - 1;
+            combined.assign(current.size(), 0);
 
-    // compute implicants by increasing size
-    bool new_value = true;
-    size_t cur_row = 0;
-    while (new_value || cur_row < table.size) {
-        new_value = false;
-        for (size_t i = 0; i+1 < table.cells[cur_row].size(); i++) {
-            for (auto& lhs_dontcares_entry : table.cells[cur_row][i]) {
-                auto rhs_dontcares_entry = table.cells[cur_row][i+1].find(lhs_dontcares_entry.first);
-                if (rhs_dontcares_entry != table.cells[cur_row][i+1].end()) {
-                    for (auto& lhs_number : lhs_dontcares_entry.second) {
-                        for (auto& rhs_number : rhs_dontcares_entry->second) {
-                            const I tmp_dontcares = lhs_number.first ^ rhs_number.first;
-                            // test if tmp_dontcares is a power of two
-                            if ((tmp_dontcares & (tmp_dontcares-1)) == 0) {
-                                const I number = lhs_number.first & rhs_number.first;
-                                const I dontcares = tmp_dontcares | lhs_dontcares_entry.first;
-                                table.cells[cur_row + 1][i][dontcares].insert({ number, true });
-
-                                lhs_number.second = false;
-                                rhs_number.second = false;
-                                new_value = true;
-                            }
-                        }
-                    }
+            partners.clear();
+            #pragma omp parallel if (current.size() >= PARALLEL_THRESHOLD)
+            {
+                std::vector<Implicant> local_next;
+                std::vector<size_t> local_partners;
+                #pragma omp for schedule(dynamic, 16)
+                for (size_t g = 0; g < n_groups; g++) {
+                    merge_group(g, local_next, local_partners);
+                }
+                #pragma omp critical
+                {
+                    levels[level + 1].insert(levels[level + 1].end(), local_next.begin(), local_next.end());
+                    partners.insert(partners.end(), local_partners.begin(), local_partners.end());
+                }
+            }
+
+            for (const size_t j : partners) {
+                combined[j] = 1;
+            }
+            for (size_t i = 0; i < current.size(); i++) {
+                if (!combined[i]) {
+                    primes.push_back(SpecSeq<I>(current[i].number, current[i].unspecifiedBits));
                 }
             }
         }
-        cur_row++;
+        return primes;
     }
-    table.size = cur_row;
-
-    return table;
-}
+};
 
 template<typename I>
 std::vector<SpecSeq<I>> quine_prime_implicants(const int num_bits, const std::vector<SpecSeq<I>>& values) {
     if (values.size() == 1) {
         return { values[0] };
     }
-    if (values.size() == ((size_t)1 << num_bits)) {
+    if (num_bits < 64 && values.size() == ((size_t)1 << num_bits)) {
         // Assuming all values are distinct, all values can be combined.
         // Directly return minimal implicant for this number of bits.
         return { true_clause<I>(num_bits) };
     }
 
-    std::vector<SpecSeq<I>> prime_implicants;
+    QuineTable<I> table(num_bits, values);
+    return table.prime_implicants();
+}
+
+// prime implicants covering all values, where the essential prime implicants
+// are taken first and then greedily the ones covering most remaining values
+template<typename I>
+std::vector<SpecSeq<I>> quine_prime_implicant_cover(const int num_bits, const std::vector<SpecSeq<I>>& values) {
+    const std::vector<SpecSeq<I>> primes = quine_prime_implicants(num_bits, values);
 
-    quine_table<I> table = compute_quine_table(num_bits, values);
+    // distinct values sorted by unspecified bits and number, and their distinct unspecified bits
+    std::vector<std::pair<I, I>> sorted_values;
+    sorted_values.reserve(values.size());
+    for (const SpecSeq<I>& val : values) {
+        sorted_values.push_back({ val.unspecifiedBits, val.number & ~val.unspecifiedBits });
+    }
+    std::sort(sorted_values.begin(), sorted_values.end());
+    sorted_values.erase(std::unique(sorted_values.begin(), sorted_values.end()), sorted_values.end());
+    std::vector<I> masks;
+    for (const auto& val : sorted_values) {
+        if (masks.empty() || masks.back() != val.first) {
+            masks.push_back(val.first);
+        }
+    }
 
-    for (size_t s = 0; s < table.size; s++) {
-        for (size_t i = 0; i < table.cells[s].size(); i++) {
-            for (const auto& dontcares_entry : table.cells[s][i]) {
-                for (const auto& number_entry: dontcares_entry.second) {
-                    if (number_entry.second) {
-                        prime_implicants.push_back(SpecSeq<I>(number_entry.first, dontcares_entry.first));
-                    }
+    // values covered by each prime implicant, found by enumerating its subcubes
+    // with the unspecified bits of some value
+    std::vector<std::vector<size_t>> covered_values(primes.size());
+    std::vector<size_t> n_covering(sorted_values.size(), 0);
+    std::vector<size_t> covering(sorted_values.size());
+    for (size_t p = 0; p < primes.size(); p++) {
+        const I unspecified = primes[p].unspecifiedBits;
+        const I number = primes[p].number & ~unspecified;
+        for (const I& mask : masks) {
+            if ((mask & ~unspecified) != 0) {
+                continue;
+            }
+            const I free = unspecified & ~mask;
+            I sub = 0;
+            do {
+                const std::pair<I, I> val(mask, number | sub);
+                const auto it = std::lower_bound(sorted_values.begin(), sorted_values.end(), val);
+                if (it != sorted_values.end() && *it == val) {
+                    const size_t v = it - sorted_values.begin();
+                    covered_values[p].push_back(v);
+                    covering[v] = p;
+                    n_covering[v]++;
                 }
+                sub = (sub - free) & free;
+            } while (sub != 0);
+        }
+    }
+
+    std::vector<SpecSeq<I>> cover;
+    std::vector<bool> is_covered(sorted_values.size(), false);
+    std::vector<bool> is_selected(primes.size(), false);
+    auto select = [&](const size_t p) {
+        is_selected[p] = true;
+        cover.push_back(primes[p]);
+        for (const size_t v : covered_values[p]) {
+            is_covered[v] = true;
+        }
+    };
+    auto uncovered_count = [&](const size_t p) {
+        size_t count = 0;
+        for (const size_t v : covered_values[p]) {
+            count += is_covered[v] ? 0 : 1;
+        }
+        return count;
+    };
+
+    for (size_t v = 0; v < sorted_values.size(); v++) {
+        if (n_covering[v] == 1 && !is_selected[covering[v]]) {
+            select(covering[v]);
+        }
+    }
+
+    // the counts only decrease, so an entry whose count is still up to date
+    // is the best one, where ties are won by the later, i.e. larger, prime implicant
+    std::priority_queue<std::pair<size_t, size_t>> candidates;
+    for (size_t p = 0; p < primes.size(); p++) {
+        if (!is_selected[p]) {
+            const size_t count = uncovered_count(p);
+            if (count > 0) {
+                candidates.push({ count, p });
             }
         }
     }
+    while (!candidates.empty()) {
+        const size_t p = candidates.top().second;
+        const size_t old_count = candidates.top().first;
+        candidates.pop();
+        const size_t count = uncovered_count(p);
+        if (count == old_count) {
+            select(p);
+        }
+        else if (count > 0) {
+            candidates.push({ count, p });
+        }
+    }
 
-    return prime_implicants;
+    return cover;
 }
 
 template<typename I>
@@ -150,23 +281,18 @@ SpecSeq<I> quine_minimal_implicant(const int num_bits, const std::vector<SpecSeq
     if (values.size() == 1) {
         return values[0];
     }
-    else if (values.size() == ((size_t)1 << num_bits)) {
+    else if (num_bits < 64 && values.size() == ((size_t)1 << num_bits)) {
         // Assuming all values are distinct, all values can be combined.
         // Directly return minimal implicant for this number of bits.
         return true_clause<I>(num_bits);
     }
 
-    quine_table<I> table = compute_quine_table(num_bits, values);
-
-    const size_t s = table.size - 1;
-    for (size_t i = 0; i < table.cells[s].size(); i++) {
-        for (const auto& dontcares_entry : table.cells[s][i]) {
-            for (const auto& number_entry: dontcares_entry.second) {
-                std::cout << "Returning minimal implicant " << SpecSeq<I>(number_entry.first, dontcares_entry.first).toString(num_bits) << std::endl;
-                return SpecSeq<I>(number_entry.first, dontcares_entry.first);
-            }
-        }
+    const std::vector<SpecSeq<I>> primes = quine_prime_implicants(num_bits, values);
+    if (primes.empty()) {
+        throw std::invalid_argument("empty set of implicants");
     }
-
-    throw std::invalid_argument("empty set of implicants");
+    // the first prime implicant with the most unspecified bits
+    return *std::max_element(primes.begin(), primes.end(), [](const SpecSeq<I>& a, const SpecSeq<I>& b) {
+        return popcount(a.unspecifiedBits) < popcount(b.unspecifiedBits);
+    });
 }
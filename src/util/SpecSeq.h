@@ -17,6 +17,8 @@
 #include "cuddObj.hh"
 #include <boost/functional/hash.hpp>
 
+#include "Letter.h"
+
 // count the number of set bits in a number
 template <typename I>
 inline
@@ -113,9 +115,8 @@ struct SpecSeq {
         constexpr int bitwidth = std::numeric_limits<I>::digits + std::numeric_limits<I>::is_signed;
         int array[bitwidth];
         for (int b = 0; b < numBits; b++) {
-            const I bit = ((I)1 << b);
-            if ((unspecifiedBits & bit) == 0) {
-                array[b] = (number & bit) >> b;
+            if (!test_letter_bit(unspecifiedBits, b)) {
+                array[b] = test_letter_bit(number, b) ? 1 : 0;
             }
             else {
                 array[b] = -1;
@@ -126,9 +127,9 @@ struct SpecSeq {
 
     std::string toString(const int numBits) const {
         std::stringstream s;
-        for (I val = 1; val < ((I)1 << numBits); val <<= 1) {
-            if ((unspecifiedBits & val) == 0) {
-                if ((number & val) == 0) {
+        for (int b = 0; b < numBits; b++) {
+            if (!test_letter_bit(unspecifiedBits, b)) {
+                if (!test_letter_bit(number, b)) {
                     s << "0";
                 }
                 else {
@@ -158,7 +159,7 @@ struct SpecSeq {
                     empty = false;
                 }
 
-                I mask = (((I)1 << numBits) - 1);
+                I mask = low_bits_mask<I>(numBits);
                 I num = (number >> startBit) & mask;
                 I unspec = (unspecifiedBits >> startBit) & mask;
                 if (unspec != mask) {
@@ -176,7 +177,7 @@ struct SpecSeq {
     std::string toStateLabelledString(const std::vector<int>& accumulatedBits) const {
         std::stringstream s;
         int totalBits = accumulatedBits.back();
-        if (unspecifiedBits == (((I)1 << totalBits) - 1)) {
+        if (unspecifiedBits == low_bits_mask<I>(totalBits)) {
             // add top/true
             s << "&#8868;";
         }
@@ -187,7 +188,7 @@ struct SpecSeq {
                 int endBit = accumulatedBits[i+1];
                 int numBits = endBit - startBit;
                 if (numBits > 0) {
-                    I mask = (((I)1 << numBits) - 1);
+                    I mask = low_bits_mask<I>(numBits);
                     I num = (number >> startBit) & mask;
                     I unspec = (unspecifiedBits >> startBit) & mask;
                     if (unspec != mask) {
@@ -224,7 +225,7 @@ struct SpecSeq {
 
     std::string toLabelledString(const int numBits, const std::vector<std::string>& bitNames) const {
         std::stringstream s;
-        if (unspecifiedBits == (((I)1 << numBits) - 1)) {
+        if (unspecifiedBits == low_bits_mask<I>(numBits)) {
             // add top/true
             s << "&#8868;";
         }
@@ -255,21 +256,22 @@ struct SpecSeq {
     friend std::ostream &operator<<(std::ostream &out, const SpecSeq<I>& output) {
         std::vector<int> bits;
         constexpr int num_bits = 8;
-        int count = 0;
-        I n = output.number;
-        I d = output.unspecifiedBits;
+        constexpr int bitwidth = std::numeric_limits<I>::digits;
+        // at least num_bits bits, and all bits up to the highest set bit of the number
+        int count = num_bits;
+        for (int b = num_bits; b < bitwidth; b++) {
+            if (test_letter_bit(output.number, b)) {
+                count = b + 1;
+            }
+        }
 
-        while (n > 0 || count < num_bits) {
-            if (d%2 == 0) {
-                bits.push_back(n%2);
+        for (int b = 0; b < count; b++) {
+            if (!test_letter_bit(output.unspecifiedBits, b)) {
+                bits.push_back(test_letter_bit(output.number, b) ? 1 : 0);
             }
             else {
                 bits.push_back(2);
             }
-
-            n >>= 1;
-            d >>= 1;
-            count++;
         }
 
         for (auto bit = bits.rbegin(); bit != bits.rend(); bit++) {
@@ -296,76 +298,5 @@ struct std::hash<SpecSeq<I>> {
 
 template <typename I>
 SpecSeq<I> true_clause(const int numBits) {
-    return SpecSeq<I>(0, ((I)1 << numBits) - 1);
+    return SpecSeq<I>(0, low_bits_mask<I>(numBits));
 }
-
-template <typename I>
-class BDDtoSpecSeqIterator {
-private:
-    BDD bdd;
-    const int numBits;
-    bool done_;
-
-    // current cube
-    DdGen* gen;
-    int* cube;
-    CUDD_VALUE_TYPE value;
-    SpecSeq<I> current;
-
-    void update() {
-        if (Cudd_IsGenEmpty(gen)) {
-            done_ = true;
-        }
-        else {
-            // create SpecSeq
-            current = SpecSeq<I>();
-
-            for (int i = 0; i < numBits; i++) {
-                const I b = ((I)1 << i);
-                switch (cube[i]) {
-                    case 0:
-                        // bit not set
-                        break;
-                    case 1:
-                        // bit set
-                        current.number |= b;
-                        break;
-                    case 2:
-                        // unspecified bit
-                        current.unspecifiedBits |= b;
-                        break;
-                }
-            }
-        }
-    }
-
-public:
-    BDDtoSpecSeqIterator(BDD bdd, const int numBits) :
-        bdd(bdd), numBits(numBits), done_(false)
-    {
-        // initialize gen and grab first cube
-        gen = Cudd_FirstCube(bdd.manager(), bdd.getNode(), &cube, &value);
-        update();
-    }
-
-    ~BDDtoSpecSeqIterator() {
-        Cudd_GenFree(gen);
-    }
-
-    inline void operator++() {
-        // grab next cube
-        Cudd_NextCube(gen, &cube, &value);
-        update();
-    }
-    inline void operator++(int) {
-        operator++();
-    }
-
-    inline const SpecSeq<I> operator*() const {
-        return current;
-    }
-
-    inline bool done() const {
-        return done_;
-    }
-};
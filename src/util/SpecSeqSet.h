@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "SpecSeq.h"
+
+/*
+ * Set of cubes stored as structure of arrays, with batch operations that
+ * test a cube against all cubes in a range. For 64-bit cubes, the tests use
+ * AVX2 if the compiler targets it (CMake option USE_AVX2), and otherwise
+ * scalar loops that the compiler may vectorize.
+ */
+template <typename I>
+class SpecSeqSet {
+public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+private:
+    std::vector<I> numbers;
+    std::vector<I> unspecifiedBits;
+
+    // relation of the cubes in the set to the query cube
+    enum class Relation { OVERLAPPING, SUPERSET, SUBSET, EQUAL };
+
+    // bits violating the relation, i.e. the cubes are in relation iff this is zero
+    template <Relation R>
+    static inline I violation(const I n, const I u, const I s, const I su) {
+        if constexpr (R == Relation::OVERLAPPING) {
+            return (n ^ s) & ~(u | su);
+        }
+        else if constexpr (R == Relation::SUPERSET) {
+            return (su | (n ^ s)) & ~u;
+        }
+        else if constexpr (R == Relation::SUBSET) {
+            return (u | (n ^ s)) & ~su;
+        }
+        else {
+            return (n ^ s) | (u ^ su);
+        }
+    }
+
+#if defined(__AVX2__)
+    template <Relation R>
+    static inline __m256i violation(const __m256i n, const __m256i u, const __m256i s, const __m256i su) {
+        if constexpr (R == Relation::OVERLAPPING) {
+            return _mm256_andnot_si256(_mm256_or_si256(u, su), _mm256_xor_si256(n, s));
+        }
+        else if constexpr (R == Relation::SUPERSET) {
+            return _mm256_andnot_si256(u, _mm256_or_si256(su, _mm256_xor_si256(n, s)));
+        }
+        else if constexpr (R == Relation::SUBSET) {
+            return _mm256_andnot_si256(su, _mm256_or_si256(u, _mm256_xor_si256(n, s)));
+        }
+        else {
+            return _mm256_or_si256(_mm256_xor_si256(n, s), _mm256_xor_si256(u, su));
+        }
+    }
+#endif
+
+    // first index in [begin, end) of a cube in relation to the query cube
+    template <Relation R>
+    size_t find(const SpecSeq<I>& seq, size_t begin, size_t end) const {
+        end = std::min(end, numbers.size());
+        const I s = seq.number;
+        const I su = seq.unspecifiedBits;
+        size_t i = begin;
+#if defined(__AVX2__)
+        if constexpr (sizeof(I) == sizeof(long long)) {
+            const __m256i vs = _mm256_set1_epi64x((long long)s);
+            const __m256i vsu = _mm256_set1_epi64x((long long)su);
+            const __m256i zero = _mm256_setzero_si256();
+            for (; i + 4 <= end; i += 4) {
+                const __m256i n = _mm256_loadu_si256((const __m256i*)(numbers.data() + i));
+                const __m256i u = _mm256_loadu_si256((const __m256i*)(unspecifiedBits.data() + i));
+                const __m256i match = _mm256_cmpeq_epi64(violation<R>(n, u, vs, vsu), zero);
+                const int mask = _mm256_movemask_pd(_mm256_castsi256_pd(match));
+                if (mask != 0) {
+                    return i + __builtin_ctz(mask);
+                }
+            }
+        }
+#endif
+        // blocks without early exit inside, so that the loop can be vectorized
+        constexpr size_t BLOCK = 8;
+        for (; i + BLOCK <= end; i += BLOCK) {
+            bool any = false;
+            for (size_t j = i; j < i + BLOCK; j++) {
+                any |= violation<R>(numbers[j], unspecifiedBits[j], s, su) == 0;
+            }
+            if (any) {
+                break;
+            }
+        }
+        for (; i < end; i++) {
+            if (violation<R>(numbers[i], unspecifiedBits[i], s, su) == 0) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+public:
+    SpecSeqSet() {}
+    SpecSeqSet(const std::vector<SpecSeq<I>>& seqs) {
+        reserve(seqs.size());
+        for (const SpecSeq<I>& seq : seqs) {
+            push_back(seq);
+        }
+    }
+
+    inline size_t size() const { return numbers.size(); }
+    inline bool empty() const { return numbers.empty(); }
+    inline void reserve(const size_t n) {
+        numbers.reserve(n);
+        unspecifiedBits.reserve(n);
+    }
+    inline void clear() {
+        numbers.clear();
+        unspecifiedBits.clear();
+    }
+
+    inline SpecSeq<I> operator[](const size_t i) const {
+        return SpecSeq<I>(numbers[i], unspecifiedBits[i]);
+    }
+    inline void push_back(const SpecSeq<I>& seq) {
+        numbers.push_back(seq.number);
+        unspecifiedBits.push_back(seq.unspecifiedBits);
+    }
+    // removes the cube at index i by moving the last cube there
+    inline void erase(const size_t i) {
+        numbers[i] = numbers.back();
+        unspecifiedBits[i] = unspecifiedBits.back();
+        numbers.pop_back();
+        unspecifiedBits.pop_back();
+    }
+
+    std::vector<SpecSeq<I>> toVector() const {
+        std::vector<SpecSeq<I>> seqs;
+        seqs.reserve(size());
+        for (size_t i = 0; i < size(); i++) {
+            seqs.push_back((*this)[i]);
+        }
+        return seqs;
+    }
+
+    // first cube in [begin, end) that is not disjoint from (i.e. is compatible with) seq
+    inline size_t findOverlapping(const SpecSeq<I>& seq, const size_t begin = 0, const size_t end = npos) const {
+        return find<Relation::OVERLAPPING>(seq, begin, end);
+    }
+    // first cube in [begin, end) that contains seq
+    inline size_t findSuperset(const SpecSeq<I>& seq, const size_t begin = 0, const size_t end = npos) const {
+        return find<Relation::SUPERSET>(seq, begin, end);
+    }
+    // first cube in [begin, end) that is contained in seq
+    inline size_t findSubset(const SpecSeq<I>& seq, const size_t begin = 0, const size_t end = npos) const {
+        return find<Relation::SUBSET>(seq, begin, end);
+    }
+    inline size_t findEqual(const SpecSeq<I>& seq, const size_t begin = 0, const size_t end = npos) const {
+        return find<Relation::EQUAL>(seq, begin, end);
+    }
+    inline bool contains(const SpecSeq<I>& seq) const {
+        return findEqual(seq) != npos;
+    }
+
+    // removes duplicates and cubes contained in other cubes, keeping the order of the others
+    void removeSubsumed() {
+        std::vector<bool> subsumed(size(), false);
+        for (size_t i = 0; i < size(); i++) {
+            const SpecSeq<I> seq = (*this)[i];
+            // an equal cube only subsumes cubes after it, so that one copy is kept
+            for (size_t j = findSuperset(seq); j != npos; j = findSuperset(seq, j + 1)) {
+                if (j != i && (j < i || (*this)[j] != seq)) {
+                    subsumed[i] = true;
+                    break;
+                }
+            }
+        }
+        size_t k = 0;
+        for (size_t i = 0; i < size(); i++) {
+            if (!subsumed[i]) {
+                numbers[k] = numbers[i];
+                unspecifiedBits[k] = unspecifiedBits[i];
+                k++;
+            }
+        }
+        numbers.resize(k);
+        unspecifiedBits.resize(k);
+    }
+};
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+/*
+ * Global registry of named counters, timers and histograms.
+ *
+ * Statistics are created on first use and live until the end of the
+ * program. Updates are lock-free, so references obtained once can be kept
+ * in hot paths, e.g. in a function-local static variable:
+ *
+ *     static Statistics::Counter& hits = Statistics::counter("cache.hits");
+ *     hits.add();
+ */
+class Statistics {
+public:
+    class Counter {
+    private:
+        std::atomic<uint64_t> value;
+
+    public:
+        Counter() : value(0) {}
+
+        inline void add(const uint64_t n = 1) {
+            value.fetch_add(n, std::memory_order_relaxed);
+        }
+        inline uint64_t get() const {
+            return value.load(std::memory_order_relaxed);
+        }
+    };
+
+    // accumulated time and number of timed events
+    class Timer {
+    private:
+        std::atomic<uint64_t> nanoseconds;
+        std::atomic<uint64_t> count;
+
+    public:
+        Timer() : nanoseconds(0), count(0) {}
+
+        template <typename Rep, typename Period>
+        inline void add(const std::chrono::duration<Rep, Period> dt, const uint64_t n = 1) {
+            nanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count(), std::memory_order_relaxed);
+            count.fetch_add(n, std::memory_order_relaxed);
+        }
+        inline double getSeconds() const {
+            return nanoseconds.load(std::memory_order_relaxed) * 1e-9;
+        }
+        inline uint64_t getCount() const {
+            return count.load(std::memory_order_relaxed);
+        }
+    };
+
+    // adds the time from construction to destruction to a timer
+    class ScopedTimer {
+    private:
+        Timer& timer;
+        const std::chrono::steady_clock::time_point start_time;
+
+    public:
+        ScopedTimer(Timer& timer) :
+            timer(timer),
+            start_time(std::chrono::steady_clock::now())
+        {}
+        ~ScopedTimer() {
+            timer.add(std::chrono::steady_clock::now() - start_time);
+        }
+    };
+
+    // distribution of values in buckets of powers of two, where bucket 0 holds
+    // the value 0 and bucket i > 0 holds values in [2^(i-1), 2^i)
+    class Histogram {
+    public:
+        static constexpr size_t N_BUCKETS = std::numeric_limits<uint64_t>::digits + 1;
+
+    private:
+        std::array<std::atomic<uint64_t>, N_BUCKETS> buckets;
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> sum;
+        std::atomic<uint64_t> min;
+        std::atomic<uint64_t> max;
+
+    public:
+        Histogram() :
+            count(0),
+            sum(0),
+            min(std::numeric_limits<uint64_t>::max()),
+            max(0)
+        {
+            for (auto& bucket : buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        static inline size_t bucket(uint64_t value) {
+            size_t i = 0;
+            while (value != 0) {
+                value >>= 1;
+                i++;
+            }
+            return i;
+        }
+
+        inline void add(const uint64_t value) {
+            buckets[bucket(value)].fetch_add(1, std::memory_order_relaxed);
+            count.fetch_add(1, std::memory_order_relaxed);
+            sum.fetch_add(value, std::memory_order_relaxed);
+            uint64_t cur_min = min.load(std::memory_order_relaxed);
+            while (value < cur_min && !min.compare_exchange_weak(cur_min, value, std::memory_order_relaxed));
+            uint64_t cur_max = max.load(std::memory_order_relaxed);
+            while (value > cur_max && !max.compare_exchange_weak(cur_max, value, std::memory_order_relaxed));
+        }
+
+        inline uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+        inline uint64_t getSum() const { return sum.load(std::memory_order_relaxed); }
+        inline uint64_t getMin() const { return getCount() == 0 ? 0 : min.load(std::memory_order_relaxed); }
+        inline uint64_t getMax() const { return max.load(std::memory_order_relaxed); }
+        inline uint64_t getBucket(const size_t i) const { return buckets[i].load(std::memory_order_relaxed); }
+    };
+
+private:
+    std::mutex mutex;
+    std::map<std::string, std::unique_ptr<Counter>> counters;
+    std::map<std::string, std::unique_ptr<Timer>> timers;
+    std::map<std::string, std::unique_ptr<Histogram>> histograms;
+
+    Statistics() {}
+
+    static inline Statistics& instance() {
+        static Statistics statistics;
+        return statistics;
+    }
+
+    template <typename T>
+    static inline T& get(std::map<std::string, std::unique_ptr<T>>& map, const std::string& name) {
+        Statistics& s = instance();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        std::unique_ptr<T>& value = map[name];
+        if (!value) {
+            value.reset(new T());
+        }
+        return *value;
+    }
+
+    static inline void write_string(std::ostream& out, const std::string& str) {
+        out << '"';
+        for (const char c : str) {
+            if (c == '"' || c == '\\') {
+                out << '\\' << c;
+            }
+            else if ((unsigned char)c < 0x20) {
+                out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)c << std::dec << std::setfill(' ');
+            }
+            else {
+                out << c;
+            }
+        }
+        out << '"';
+    }
+
+public:
+    Statistics(const Statistics&) = delete;
+    Statistics& operator=(const Statistics&) = delete;
+
+    static inline Counter& counter(const std::string& name) {
+        return get(instance().counters, name);
+    }
+    static inline Timer& timer(const std::string& name) {
+        return get(instance().timers, name);
+    }
+    static inline Histogram& histogram(const std::string& name) {
+        return get(instance().histograms, name);
+    }
+
+    static void writeJSON(std::ostream& out) {
+        Statistics& s = instance();
+        std::lock_guard<std::mutex> lock(s.mutex);
+
+        out << "{" << std::endl;
+        out << "  \"counters\": {";
+        bool first = true;
+        for (const auto& it : s.counters) {
+            out << (first ? "" : ",") << std::endl << "    ";
+            write_string(out, it.first);
+            out << ": " << it.second->get();
+            first = false;
+        }
+        out << std::endl << "  }," << std::endl;
+
+        out << "  \"timers\": {";
+        first = true;
+        for (const auto& it : s.timers) {
+            out << (first ? "" : ",") << std::endl << "    ";
+            write_string(out, it.first);
+            out << ": { \"count\": " << it.second->getCount();
+            out << ", \"seconds\": " << std::fixed << std::setprecision(6) << it.second->getSeconds() << " }";
+            first = false;
+        }
+        out << std::endl << "  }," << std::endl;
+
+        out << "  \"histograms\": {";
+        first = true;
+        for (const auto& it : s.histograms) {
+            const Histogram& h = *it.second;
+            out << (first ? "" : ",") << std::endl << "    ";
+            write_string(out, it.first);
+            out << ": { \"count\": " << h.getCount() << ", \"sum\": " << h.getSum();
+            out << ", \"min\": " << h.getMin() << ", \"max\": " << h.getMax() << ", \"buckets\": [";
+            // only non-empty buckets, each with the inclusive range of values
+            bool first_bucket = true;
+            for (size_t i = 0; i < Histogram::N_BUCKETS; i++) {
+                const uint64_t n = h.getBucket(i);
+                if (n > 0) {
+                    const uint64_t lower = i == 0 ? 0 : (uint64_t)1 << (i - 1);
+                    const uint64_t upper = i == 0 ? 0 : (i == Histogram::N_BUCKETS - 1 ? std::numeric_limits<uint64_t>::max() : ((uint64_t)1 << i) - 1);
+                    out << (first_bucket ? " " : ", ");
+                    out << "{ \"min\": " << lower << ", \"max\": " << upper << ", \"count\": " << n << " }";
+                    first_bucket = false;
+                }
+            }
+            out << " ] }";
+            first = false;
+        }
+        out << std::endl << "  }" << std::endl;
+        out << "}" << std::endl;
+    }
+
+    static void writeJSON(const std::string& filename) {
+        std::ofstream out(filename);
+        if (!out) {
+            throw std::runtime_error("Could not open statistics file: " + filename);
+        }
+        writeJSON(out);
+    }
+};
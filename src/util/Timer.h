@@ -3,6 +3,8 @@
 #include <iostream>
 #include <iomanip>
 
+#include "util/Statistics.h"
+
 class Timer {
   private:
     const bool timing;
@@ -18,13 +20,14 @@ class Timer {
         section = std::move(section_name);
         if (timing) {
             std::cout << " * Starting " << section << " …" << std::endl;
-            start_time = std::chrono::high_resolution_clock::now();
         }
+        start_time = std::chrono::high_resolution_clock::now();
     }
     inline void stop() {
+        stop_time = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> dt = stop_time - start_time;
+        Statistics::timer("stage." + section).add(dt);
         if (timing) {
-            stop_time = std::chrono::high_resolution_clock::now();
-            std::chrono::duration<double> dt = stop_time - start_time;
             std::cout << " * Finished " << section << ", took " << std::fixed << std::setprecision(2) << dt.count() << " seconds." << std::endl;
         }
     }
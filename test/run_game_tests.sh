@@ -0,0 +1,86 @@
+#!/bin/bash
+
+# exit on error
+set -e
+# echo commands
+set -x
+# break when pipe fails
+set -o pipefail
+
+# tool paths
+STRIX=$1
+ROOT_DIR=$2
+
+# input file
+SPECIFICATION=$3
+
+# type of test
+TEST=$4
+
+if [ "$TEST" != "REALIZABLE" ] && [ "$TEST" != "UNREALIZABLE" ]; then
+    # unknown test
+    echo "Unknown test: $TEST"
+    exit 2
+fi
+
+# temporary files
+BASE=$(basename ${SPECIFICATION%.tlsf})
+GAME=/tmp/${BASE}_game.bin
+GAME_REALIZABILITY=/tmp/${BASE}_game_r.bin
+CORRUPTED=/tmp/${BASE}_game_corrupted.bin
+IMPLEMENTATION=/tmp/${BASE}_game.aag
+
+STRIX_OPTIONS='--validate-jni -c --auto'
+
+# get formula, inputs and outputs from specification using syfco
+LTL=$(syfco -f ltl -q double -m fully $SPECIFICATION)
+INS=$(syfco --print-input-signals $SPECIFICATION)
+OUTS=$(syfco --print-output-signals $SPECIFICATION)
+
+function check_result {
+    # check if tool answers correctly (and nothing else)
+    if [ "$TEST" != "$1" ]; then
+        echo "Incorrect result for $TEST: $1"
+        exit 1
+    fi
+}
+
+# save the games with and without labels
+RESULT=$($STRIX $STRIX_OPTIONS -f "$LTL" --ins "$INS" --outs "$OUTS" --save-game $GAME -o /dev/null)
+check_result "$RESULT"
+RESULT=$($STRIX $STRIX_OPTIONS -r -f "$LTL" --ins "$INS" --outs "$OUTS" --save-game $GAME_REALIZABILITY)
+check_result "$RESULT"
+
+# solve the game with labels again and verify the solution (with time limit of 10 seconds)
+RESULT=$($STRIX $STRIX_OPTIONS --load-game $GAME -o $IMPLEMENTATION)
+check_result "$RESULT"
+$ROOT_DIR/scripts/verify.sh $IMPLEMENTATION $SPECIFICATION $TEST 10
+
+# solve the game without labels again, which only allows to check realizability
+RESULT=$($STRIX $STRIX_OPTIONS -r --load-game $GAME_REALIZABILITY)
+check_result "$RESULT"
+
+# corrupted games have to be rejected with an error message instead of crashing
+function check_rejected {
+    set +e
+    ERROR=$($STRIX $STRIX_OPTIONS --load-game $CORRUPTED 2>&1 >/dev/null)
+    STATUS=$?
+    set -e
+    if [ $STATUS -ne 1 ] || [[ "${ERROR,,}" != *"parity game file"* ]]; then
+        echo "Corrupted game not rejected ($1): status $STATUS, $ERROR"
+        exit 1
+    fi
+}
+
+# truncated to half of its size
+SIZE=$(stat -c %s $GAME)
+head -c $((SIZE / 2)) $GAME > $CORRUPTED
+check_rejected "truncated"
+
+# number of environment nodes in the header overwritten
+cp $GAME $CORRUPTED
+printf '\xff\xff\xff\xff\xff\xff\xff\xff' | dd of=$CORRUPTED bs=1 seek=40 conv=notrunc status=none
+check_rejected "header"
+
+# remove temporary files
+rm -f $GAME $GAME_REALIZABILITY $CORRUPTED $IMPLEMENTATION
@@ -0,0 +1,34 @@
+#!/bin/bash
+
+# exit on error
+set -e
+# echo commands
+set -x
+# break when pipe fails
+set -o pipefail
+
+# tool path
+STRIX_PG=$1
+
+# input file
+GAME=$2
+
+# expected winner of the initial node
+TEST=$3
+
+STRIX_PG_OPTIONS='--timing'
+
+# run the tool
+RESULT=$($STRIX_PG $STRIX_PG_OPTIONS $GAME | tail -n 1)
+
+if [ "$TEST" == "EVEN" ] || [ "$TEST" == "ODD" ]; then
+    # check if tool answers correctly
+    if [ "$TEST" != "$RESULT" ]; then
+        echo "Incorrect result for $TEST: $RESULT"
+        exit 1
+    fi
+else
+    # unknown test
+    echo "Unknown test: $TEST"
+    exit 2
+fi
@@ -17,11 +17,21 @@ SPECIFICATION=$3
 # type of test
 TEST=$4
 
+# additional options (optional), e.g. for the exploration
+EXTRA_OPTIONS=${5:--e pq}
+
 # temporary files
-BASE=$(basename ${2%.tlsf})
-IMPLEMENTATION=/tmp/$BASE.aag
+BASE=$(basename ${SPECIFICATION%.tlsf})
+MODE=$(echo "$EXTRA_OPTIONS" | tr -c '[:alnum:]\n' '_')
+IMPLEMENTATION=/tmp/${BASE}${MODE}.aag
+
+STRIX_OPTIONS="--validate-jni -c --auto $EXTRA_OPTIONS"
 
-STRIX_OPTIONS='--validate-jni -e pq -c --auto'
+# with -r, there is no implementation to verify
+ONLY_REALIZABILITY=false
+if [[ " $EXTRA_OPTIONS " == *" -r "* ]]; then
+    ONLY_REALIZABILITY=true
+fi
 
 # get formula, inputs and outputs from specification using syfco
 LTL=$(syfco -f ltl -q double -m fully $SPECIFICATION)
@@ -39,7 +49,9 @@ if [ "$TEST" == "REALIZABLE" ] || [ "$TEST" == "UNREALIZABLE" ]; then
     fi
 
     # verify solution (with time limit of 10 seconds)
-    $ROOT_DIR/scripts/verify.sh $IMPLEMENTATION $SPECIFICATION $TEST 10
+    if [ "$ONLY_REALIZABILITY" == false ]; then
+        $ROOT_DIR/scripts/verify.sh $IMPLEMENTATION $SPECIFICATION $TEST 10
+    fi
 
     # remove solution
     rm -f $IMPLEMENTATION